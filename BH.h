@@ -1,7 +1,11 @@
 #ifndef BH_H
 #define BH_H
+#include <algorithm>
+#include <memory>
+#include <new>
 #include <string>
 #include "DA.h"
+#include "HC.h"
 
 namespace BH {
     template<typename T>
@@ -26,26 +30,12 @@ namespace BH {
                     std::to_string(int(this->Size())) + ")");
             }
 
-            if (index) {
-                size_t parent = NodeParentIndex(index);
-
-                try {
-                    if (cmp_lgreater) {
-                        if (cmp_lgreater((*this)[index], (*this)[parent])) {
-                            Swap(index, parent);
-                            HeapifyUp(parent, cmp_lgreater);
-                        }
-                    } else if constexpr (std::is_arithmetic_v<T>) {
-                        if ((*this)[index] > (*this)[parent]) {
-                            Swap(index, parent);
-                            HeapifyUp(parent, cmp_lgreater);
-                        }
-                    } else {
-                        throw std::runtime_error("T was not arithmetic and no cmp was provided");
-                    }
-                } catch (const std::exception &ex) {
-                    throw std::runtime_error("BH::HeapifyUp() -> " + std::string(ex.what()));
-                }
+            if (cmp_lgreater) {
+                HC::SiftUp(this->arr, index, cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                HC::SiftUp(this->arr, index, HC::LGreater<T>());
+            } else {
+                throw std::runtime_error("BH::HeapifyUp(): T was not arithmetic and no cmp was provided");
             }
         }
 
@@ -56,35 +46,12 @@ namespace BH {
                     std::to_string(int(this->Size())) + ")");
             }
 
-            size_t left = NodeLeftIndex(index);
-            size_t right = NodeRightIndex(index);
-            size_t largest = index;
-
-            try {
-                if (cmp_lgreater) {
-                    if (left < this->Size() && cmp_lgreater((*this)[left], (*this)[largest])) {
-                        largest = left;
-                    }
-                    if (right < this->Size() && cmp_lgreater((*this)[right], (*this)[largest])) {
-                        largest = right;
-                    }
-                } else if constexpr (std::is_arithmetic_v<T>) {
-                    if (left < this->Size() && (*this)[left] > (*this)[largest]) {
-                        largest = left;
-                    }
-                    if (right < this->Size() && (*this)[right] > (*this)[largest]) {
-                        largest = right;
-                    }
-                } else {
-                    throw std::runtime_error("T was not arithmetic and no cmp was provided");
-                }
-
-                if (largest != index) {
-                    Swap(index, largest);
-                    HeapifyDown(largest, cmp_lgreater);
-                }
-            } catch (const std::exception &ex) {
-                throw std::runtime_error("BH::HeapifyDown() -> " + std::string(ex.what()));
+            if (cmp_lgreater) {
+                HC::SiftDown(this->arr, this->size, index, cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                HC::SiftDown(this->arr, this->size, index, HC::LGreater<T>());
+            } else {
+                throw std::runtime_error("BH::HeapifyDown(): T was not arithmetic and no cmp was provided");
             }
         }
 
@@ -94,6 +61,7 @@ namespace BH {
 
                 (*this)[index1] = (*this)[index2];
                 (*this)[index2] = temp;
+                OC::Add(OC::MOVES, 2);
             }
         }
 
@@ -115,7 +83,7 @@ namespace BH {
 
         void Push(T data, bool (*cmp_lgreater)(T, T) = nullptr) {
             try {
-                this->Push(data);
+                DA::DynArr<T>::Push(data);
                 HeapifyUp(this->Size() - 1, cmp_lgreater);
             } catch (const std::exception &ex) {
                 throw std::runtime_error("BH::Push() -> " + std::string(ex.what()));
@@ -131,7 +99,7 @@ namespace BH {
 
             try {
                 Swap(index, this->Size() - 1);
-                this->Pop(this->Size() - 1);
+                DA::DynArr<T>::Pop(this->Size() - 1);
                 if (this->Size()) {
                     HeapifyDown(index, cmp_lgreater);
                 }
@@ -153,9 +121,16 @@ namespace BH {
             return root;
         }
 
+        void ReplaceTop(T data, bool (*cmp_lgreater)(T, T) = nullptr) {
+            if (!this->Size()) { throw std::length_error("BH::ReplaceTop(): heap was empty"); }
+
+            this->arr[0] = data;
+            HeapifyDown(0, cmp_lgreater);
+        }
+
         void Erase() {
             try {
-                this->Erase();
+                DA::DynArr<T>::Erase();
             } catch (const std::exception &ex) {
                 throw std::runtime_error("BH::Erase() -> " + std::string(ex.what()));
             }
@@ -165,11 +140,101 @@ namespace BH {
             std::string text = ">>> Binary Heap <<<\n";
             text += "is based on\n";
 
-            text += this->ToString(limit, cmp_string);
+            text += DA::DynArr<T>::ToString(limit, cmp_string);
 
             return text;
         }
     };
+
+    template<typename T, size_t ARITY = 4>
+    class DaryHeap {
+        static_assert(ARITY == 2 || ARITY == 4 || ARITY == 8, "BH::DaryHeap: ARITY must be 2, 4 or 8");
+
+        static constexpr size_t CACHE_LINE = 64;
+        static constexpr size_t PADDING = ARITY - 1;
+
+        T *storage;
+        T *arr;
+        size_t size;
+        size_t capacity;
+
+    public:
+        DaryHeap(size_t in_capacity = 1) {
+            size = 0;
+            capacity = in_capacity;
+            try {
+                storage = static_cast<T *>(::operator new((capacity + PADDING) * sizeof(T),
+                                                          std::align_val_t(CACHE_LINE)));
+            } catch (const std::bad_alloc &ex) {
+                throw std::runtime_error("BH::DaryHeap::Constructor -> " + std::string(ex.what()));
+            }
+            arr = storage + PADDING;
+        }
+
+        template<typename Cmp>
+        DaryHeap(const T *in_arr, size_t n, Cmp cmp_lgreater) : DaryHeap(n ? n : 1) {
+            std::uninitialized_copy_n(in_arr, n, arr);
+            size = n;
+            HC::MakeDaryHeap<ARITY>(arr, size, cmp_lgreater);
+        }
+
+        DaryHeap(const DaryHeap &) = delete;
+
+        DaryHeap &operator=(const DaryHeap &) = delete;
+
+        ~DaryHeap() {
+            std::destroy_n(arr, size);
+            ::operator delete(storage, std::align_val_t(CACHE_LINE));
+        }
+
+        size_t Size() const {
+            return size;
+        }
+
+        size_t Capacity() const {
+            return capacity;
+        }
+
+        static constexpr size_t Arity() {
+            return ARITY;
+        }
+
+        template<typename Cmp>
+        void Push(T data, Cmp cmp_lgreater) {
+            if (size == capacity) {
+                throw std::length_error(
+                    "BH::DaryHeap::Push(): heap was full (" + std::to_string(int(capacity)) + ")");
+            }
+
+            new(arr + size) T(std::move(data));
+            HC::DarySiftUp<ARITY>(arr, size, cmp_lgreater);
+            size++;
+        }
+
+        template<typename Cmp>
+        T Poll(Cmp cmp_lgreater) {
+            if (!size) { throw std::length_error("BH::DaryHeap::Poll(): heap was empty"); }
+
+            T root = std::move(arr[0]);
+            size--;
+            if (size) {
+                arr[0] = std::move(arr[size]);
+                HC::DarySiftDown<ARITY>(arr, size, 0, cmp_lgreater);
+            }
+            std::destroy_at(arr + size);
+
+            return root;
+        }
+
+        template<typename Cmp>
+        void Sort(Cmp cmp_lgreater) {
+            HC::SortDaryHeap<ARITY>(arr, size, cmp_lgreater);
+        }
+
+        void CopyTo(T *out_arr) const {
+            std::copy_n(arr, size, out_arr);
+        }
+    };
 }
 
 #endif
@@ -0,0 +1,340 @@
+#ifndef BM_H
+#define BM_H
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BM {
+    struct Options {
+        std::string suite = "ints";
+        std::vector<std::string> distributions = {"uniform"};
+        std::vector<std::string> algorithms = {"all"};
+        std::vector<size_t> sizes = {10, 100, 1000, 10000, 100000, 1000000};
+        std::vector<unsigned int> threads;
+        int m = 10000000;
+        size_t k = 100;
+        uint64_t seed = 1;
+        size_t trials = 5;
+        size_t warmup = 1;
+        std::string format = "text";
+        std::string output;
+        size_t preview = 0;
+        size_t memory = 0;
+        bool help = false;
+    };
+
+    class Metrics {
+        std::vector<std::pair<std::string, double> > values;
+
+    public:
+        void Set(const std::string &name, double value) {
+            for (auto &[key, data]: values) {
+                if (key == name) {
+                    data = value;
+                    return;
+                }
+            }
+            values.emplace_back(name, value);
+        }
+
+        double Get(const std::string &name, double fallback = 0) const {
+            for (const auto &[key, data]: values) {
+                if (key == name) {
+                    return data;
+                }
+            }
+            return fallback;
+        }
+
+        const std::vector<std::pair<std::string, double> > &Values() const {
+            return values;
+        }
+    };
+
+    struct Stats {
+        double min = 0;
+        double median = 0;
+        double p95 = 0;
+        double p99 = 0;
+        double mean = 0;
+    };
+
+    struct Result {
+        std::string suite;
+        std::string distribution;
+        std::string algorithm;
+        unsigned int threads = 0;
+        size_t n = 0;
+        int m = 0;
+        uint64_t seed = 0;
+        std::vector<double> times;
+        bool correct = false;
+        Metrics metrics;
+    };
+
+    inline std::string Usage() {
+        return "Usage: Sorting_Algorithms_Comparison [options]\n"
+                "  --suite ints|objects|all|external|merge\n"
+                "                               input type to benchmark (default: ints); external sorts a binary\n"
+                "                               file of ints on disk, merge merges k = 2..1024 sorted runs; neither\n"
+                "                               is part of all\n"
+                "  --dist d1,d2,...             input distributions (default: uniform): uniform, sorted, reverse,\n"
+                "                               nearly-sorted[:pct], sawtooth[:teeth], organ-pipe, few-unique[:k],\n"
+                "                               zipf[:s], gaussian[:clusters], all-equal\n"
+                "  --algorithms a,b,...|all     algorithms to run (default: all)\n"
+                "  --sizes n1,n2,...            input sizes, e.g. 1000,1e6 (default: 10..1e6)\n"
+                "  --max-order k                shortcut for --sizes 10,100,...,10^k\n"
+                "  --m m                        key range [0, m] (default: 1e7)\n"
+                "  --k k                        elements kept by top-k (default: 100)\n"
+                "  --seed s                     random seed (default: 1)\n"
+                "  --trials t                   timed trials per algorithm (default: 5)\n"
+                "  --warmup w                   untimed warmup runs per algorithm (default: 1)\n"
+                "  --threads t1,t2,...          thread counts for parallel sorts (default: 1,2,4..max)\n"
+                "  --format text|csv|json       report format (default: text)\n"
+                "  --output path                write csv/json report to path instead of stdout\n"
+                "  --preview k                  print the first k elements of every result\n"
+                "  --memory bytes               memory budget of the external suite (default: max(262144, n * 4 / 8))\n"
+                "  --help                       print this message\n";
+    }
+
+    inline std::vector<std::string> SplitList(const std::string &text) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        std::string item;
+
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+
+        return items;
+    }
+
+    inline double ParseNumber(const std::string &option, const std::string &text) {
+        try {
+            size_t used = 0;
+            double value = std::stod(text, &used);
+            if (used != text.size() || value < 0) {
+                throw std::invalid_argument(text);
+            }
+            return value;
+        } catch (const std::exception &) {
+            throw std::invalid_argument("BM::ParseOptions(): " + option + " expected a non-negative number, got \"" +
+                                        text + "\"");
+        }
+    }
+
+    inline Options ParseOptions(int argc, char **argv) {
+        Options options;
+
+        for (int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "--help" || option == "-h") {
+                options.help = true;
+                continue;
+            }
+
+            static const std::vector<std::string> KNOWN = {
+                "--suite", "--dist", "--algorithms", "--sizes", "--max-order", "--m", "--k", "--seed", "--trials", "--warmup",
+                "--threads", "--format", "--output", "--preview", "--memory"
+            };
+            if (std::find(KNOWN.begin(), KNOWN.end(), option) == KNOWN.end()) {
+                throw std::invalid_argument("BM::ParseOptions(): unknown option \"" + option + "\"");
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("BM::ParseOptions(): " + option + " expected a value");
+            }
+            std::string value = argv[++i];
+
+            if (option == "--suite") {
+                if (value != "ints" && value != "objects" && value != "all" && value != "external" &&
+                    value != "merge") {
+                    throw std::invalid_argument("BM::ParseOptions(): unknown suite \"" + value + "\"");
+                }
+                options.suite = value;
+            } else if (option == "--dist") {
+                options.distributions = SplitList(value);
+            } else if (option == "--algorithms") {
+                options.algorithms = SplitList(value);
+            } else if (option == "--sizes") {
+                options.sizes.clear();
+                for (const std::string &item: SplitList(value)) {
+                    options.sizes.push_back(static_cast<size_t>(ParseNumber(option, item)));
+                }
+            } else if (option == "--max-order") {
+                options.sizes.clear();
+                for (int order = 1; order <= static_cast<int>(ParseNumber(option, value)); order++) {
+                    options.sizes.push_back(static_cast<size_t>(std::pow(10, order)));
+                }
+            } else if (option == "--m") {
+                double m = ParseNumber(option, value);
+                if (m < 1 || m > INT_MAX) {
+                    throw std::invalid_argument("BM::ParseOptions(): --m must be between 1 and " +
+                                                std::to_string(INT_MAX));
+                }
+                options.m = static_cast<int>(m);
+            } else if (option == "--k") {
+                options.k = static_cast<size_t>(ParseNumber(option, value));
+                if (!options.k) {
+                    throw std::invalid_argument("BM::ParseOptions(): --k must be at least 1");
+                }
+            } else if (option == "--seed") {
+                options.seed = static_cast<uint64_t>(ParseNumber(option, value));
+            } else if (option == "--trials") {
+                options.trials = static_cast<size_t>(ParseNumber(option, value));
+                if (!options.trials) {
+                    throw std::invalid_argument("BM::ParseOptions(): --trials must be at least 1");
+                }
+            } else if (option == "--warmup") {
+                options.warmup = static_cast<size_t>(ParseNumber(option, value));
+            } else if (option == "--threads") {
+                options.threads.clear();
+                for (const std::string &item: SplitList(value)) {
+                    options.threads.push_back(static_cast<unsigned int>(ParseNumber(option, item)));
+                }
+            } else if (option == "--format") {
+                if (value != "text" && value != "csv" && value != "json") {
+                    throw std::invalid_argument("BM::ParseOptions(): unknown format \"" + value + "\"");
+                }
+                options.format = value;
+            } else if (option == "--output") {
+                options.output = value;
+            } else if (option == "--memory") {
+                options.memory = static_cast<size_t>(ParseNumber(option, value));
+            } else {
+                options.preview = static_cast<size_t>(ParseNumber(option, value));
+            }
+        }
+
+        return options;
+    }
+
+    inline bool Selected(const Options &options, const std::string &algorithm) {
+        for (const std::string &name: options.algorithms) {
+            if (name == "all" || name == algorithm) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline double Percentile(const std::vector<double> &sorted_times, double percent) {
+        size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted_times.size()));
+        return sorted_times[rank ? rank - 1 : 0];
+    }
+
+    inline Stats Summarize(std::vector<double> times) {
+        Stats stats;
+        if (times.empty()) {
+            return stats;
+        }
+
+        std::sort(times.begin(), times.end());
+        stats.min = times.front();
+        stats.median = times.size() % 2
+                           ? times[times.size() / 2]
+                           : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+        stats.p95 = Percentile(times, 95);
+        stats.p99 = Percentile(times, 99);
+        for (double time: times) {
+            stats.mean += time;
+        }
+        stats.mean /= times.size();
+
+        return stats;
+    }
+
+    inline std::vector<std::string> MetricNames(const std::vector<Result> &results) {
+        std::vector<std::string> names;
+
+        for (const Result &result: results) {
+            for (const auto &[name, value]: result.metrics.Values()) {
+                if (std::find(names.begin(), names.end(), name) == names.end()) {
+                    names.push_back(name);
+                }
+            }
+        }
+
+        return names;
+    }
+
+    inline std::string ToCsv(const std::vector<Result> &results) {
+        std::vector<std::string> names = MetricNames(results);
+        std::ostringstream text;
+        text.precision(9);
+
+        text << "suite,distribution,algorithm,threads,n,m,seed,trials,min_s,median_s,p95_s,p99_s,mean_s,elements_per_s,"
+                "correct";
+        for (const std::string &name: names) {
+            text << "," << name;
+        }
+        text << "\n";
+
+        for (const Result &result: results) {
+            Stats stats = Summarize(result.times);
+            text << result.suite << "," << result.distribution << "," << result.algorithm << "," << result.threads
+                    << "," << result.n << "," << result.m << "," << result.seed << "," << result.times.size() << ","
+                    << stats.min << "," << stats.median << "," << stats.p95 << "," << stats.p99 << "," << stats.mean
+                    << "," << (stats.median > 0 ? result.n / stats.median : 0) << "," << (result.correct ? 1 : 0);
+
+            for (const std::string &name: names) {
+                text << ",";
+                for (const auto &[key, value]: result.metrics.Values()) {
+                    if (key == name) {
+                        text << value;
+                    }
+                }
+            }
+            text << "\n";
+        }
+
+        return text.str();
+    }
+
+    inline std::string ToJson(const std::vector<Result> &results) {
+        std::ostringstream text;
+        text.precision(9);
+
+        text << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result &result = results[i];
+            Stats stats = Summarize(result.times);
+
+            text << "  {\"suite\": \"" << result.suite << "\", \"distribution\": \"" << result.distribution
+                    << "\", \"algorithm\": \"" << result.algorithm
+                    << "\", \"threads\": " << result.threads << ", \"n\": " << result.n << ", \"m\": " << result.m
+                    << ", \"seed\": " << result.seed << ", \"trials\": " << result.times.size()
+                    << ", \"min_s\": " << stats.min << ", \"median_s\": " << stats.median << ", \"p95_s\": "
+                    << stats.p95 << ", \"p99_s\": " << stats.p99 << ", \"mean_s\": " << stats.mean
+                    << ", \"elements_per_s\": " << (stats.median > 0 ? result.n / stats.median : 0)
+                    << ", \"correct\": " << (result.correct ? "true" : "false") << ", \"times_s\": [";
+            for (size_t t = 0; t < result.times.size(); t++) {
+                text << (t ? ", " : "") << result.times[t];
+            }
+            text << "], \"metrics\": {";
+            for (size_t k = 0; k < result.metrics.Values().size(); k++) {
+                const auto &[name, value] = result.metrics.Values()[k];
+                text << (k ? ", " : "") << "\"" << name << "\": ";
+                if (std::isfinite(value)) {
+                    text << value;
+                } else {
+                    text << "null";
+                }
+            }
+            text << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        text << "]\n";
+
+        return text.str();
+    }
+}
+
+#endif
@@ -1,44 +1,100 @@
 #ifndef DA_H
 #define DA_H
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include "IS.h"
+#include "OC.h"
 
 namespace DA {
+    inline void (*on_allocate)(size_t bytes) = nullptr;
+    inline void (*on_deallocate)(size_t bytes) = nullptr;
+
     template<typename T>
     class DynArr {
     protected:
+        static constexpr bool TRIVIAL = std::is_trivially_copyable_v<T> && alignof(T) <= alignof(std::max_align_t);
+
         T *arr;
         size_t size;
         size_t capacity;
+        size_t min_capacity;
         const int FACTOR = 2;
 
-        void ExpandArray() {
-            size_t new_capacity = capacity * FACTOR;
-            T *new_arr = nullptr;
+        static T *Allocate(size_t in_capacity) {
+            OC::Add(OC::ALLOCATIONS);
+            if constexpr (TRIVIAL) {
+                void *mem = std::malloc(in_capacity * sizeof(T));
+                if (!mem) {
+                    throw std::bad_alloc();
+                }
+                if (on_allocate) {
+                    on_allocate(in_capacity * sizeof(T));
+                }
+                return static_cast<T *>(mem);
+            } else {
+                return static_cast<T *>(::operator new(in_capacity * sizeof(T), std::align_val_t(alignof(T))));
+            }
+        }
 
-            try {
-                new_arr = new T[new_capacity];
-                TransferMainArray(new_arr, new_capacity);
-            } catch (const std::bad_alloc &ex) {
-                throw std::runtime_error("DA::ExpandArray() -> " + std::string(ex.what()));
+        static void Deallocate(T *in_arr, size_t in_capacity) {
+            if constexpr (TRIVIAL) {
+                if (in_arr && on_deallocate) {
+                    on_deallocate(in_capacity * sizeof(T));
+                }
+                std::free(in_arr);
+            } else {
+                ::operator delete(in_arr, std::align_val_t(alignof(T)));
             }
-            catch (const std::exception &ex) {
-                delete[] new_arr;
+        }
+
+        void Relocate(size_t new_capacity) {
+            if constexpr (TRIVIAL) {
+                OC::Add(OC::ALLOCATIONS);
+                void *mem = std::realloc(arr, new_capacity * sizeof(T));
+                if (!mem) {
+                    throw std::bad_alloc();
+                }
+                if (on_deallocate && arr) {
+                    on_deallocate(capacity * sizeof(T));
+                }
+                if (on_allocate) {
+                    on_allocate(new_capacity * sizeof(T));
+                }
+                arr = static_cast<T *>(mem);
+                capacity = new_capacity;
+            } else {
+                T *new_arr = Allocate(new_capacity);
+                try {
+                    TransferMainArray(new_arr, new_capacity);
+                } catch (...) {
+                    Deallocate(new_arr, new_capacity);
+                    throw;
+                }
+            }
+        }
+
+        void ExpandArray() {
+            try {
+                Relocate(capacity ? capacity * FACTOR : 1);
+            } catch (const std::exception &ex) {
                 throw std::runtime_error("DA::ExpandArray() -> " + std::string(ex.what()));
             }
         }
 
         void ReduceArray() {
             size_t new_capacity = capacity / FACTOR;
-            T *new_arr = nullptr;
+            if (new_capacity < min_capacity) {
+                new_capacity = min_capacity;
+            }
 
             try {
-                new_arr = new T[new_capacity];
-                TransferMainArray(new_arr, new_capacity);
-            } catch (const std::bad_alloc &ex) {
-                throw std::runtime_error("DA::ReduceArray() -> " + std::string(ex.what()));
-            }
-            catch (const std::exception &ex) {
-                delete[] new_arr;
+                Relocate(new_capacity);
+            } catch (const std::exception &ex) {
                 throw std::runtime_error("DA::ReduceArray() -> " + std::string(ex.what()));
             }
         }
@@ -51,11 +107,16 @@ namespace DA {
                     ") was smaller than the array size (" + std::to_string(int(size)) + ")");
             }
 
-            for (int i = 0; i < size; i++) {
-                in_arr[i] = arr[i];
+            if constexpr (TRIVIAL) {
+                if (size) {
+                    memcpy(in_arr, arr, size * sizeof(T));
+                }
+            } else {
+                std::uninitialized_move_n(arr, size, in_arr);
+                std::destroy_n(arr, size);
             }
 
-            delete[] arr;
+            Deallocate(arr, capacity);
             capacity = in_capacity;
             arr = in_arr;
         }
@@ -63,16 +124,22 @@ namespace DA {
     public:
         DynArr(size_t in_capacity = 1) {
             size = 0;
-            capacity = in_capacity;
+            capacity = in_capacity ? in_capacity : 1;
+            min_capacity = 1;
             try {
-                arr = new T[capacity];
+                arr = Allocate(capacity);
             } catch (const std::bad_alloc &ex) {
                 throw std::runtime_error("DA::Constructor -> " + std::string(ex.what()));
             }
         }
 
+        DynArr(const DynArr &) = delete;
+
+        DynArr &operator=(const DynArr &) = delete;
+
         ~DynArr() {
-            delete[] arr;
+            std::destroy_n(arr, size);
+            Deallocate(arr, capacity);
         }
 
         size_t Size() const {
@@ -87,6 +154,30 @@ namespace DA {
             return FACTOR;
         }
 
+        void Reserve(size_t in_capacity) {
+            if (in_capacity > capacity) {
+                try {
+                    Relocate(in_capacity);
+                } catch (const std::exception &ex) {
+                    throw std::runtime_error("DA::Reserve() -> " + std::string(ex.what()));
+                }
+            }
+            if (in_capacity > min_capacity) {
+                min_capacity = in_capacity;
+            }
+        }
+
+        void ShrinkToFit() {
+            min_capacity = 1;
+            if (capacity > (size ? size : 1)) {
+                try {
+                    Relocate(size ? size : 1);
+                } catch (const std::exception &ex) {
+                    throw std::runtime_error("DA::ShrinkToFit() -> " + std::string(ex.what()));
+                }
+            }
+        }
+
         void Push(T data) {
             if (size == capacity) {
                 try {
@@ -96,10 +187,27 @@ namespace DA {
                 }
             }
 
-            arr[size] = data;
+            new(arr + size) T(std::move(data));
             size++;
         }
 
+        template<typename... Args>
+        T &EmplaceBack(Args &&... args) {
+            if (size == capacity) {
+                T data(std::forward<Args>(args)...);
+                try {
+                    ExpandArray();
+                } catch (const std::exception &ex) {
+                    throw std::runtime_error("DA::EmplaceBack() -> " + std::string(ex.what()));
+                }
+                new(arr + size) T(std::move(data));
+            } else {
+                new(arr + size) T(std::forward<Args>(args)...);
+            }
+
+            return arr[size++];
+        }
+
         void Pop(size_t index) {
             if (index >= size) {
                 throw std::length_error(
@@ -107,28 +215,33 @@ namespace DA {
                     std::to_string(int(size)) + ")");
             }
 
-            if (size == capacity / FACTOR) {
+            if constexpr (TRIVIAL) {
+                memmove(arr + index, arr + index + 1, (size - index - 1) * sizeof(T));
+            } else {
+                std::move(arr + index + 1, arr + size, arr + index);
+                std::destroy_at(arr + size - 1);
+            }
+            size--;
+
+            if (capacity > min_capacity && size <= capacity / (FACTOR * FACTOR)) {
                 try {
                     ReduceArray();
                 } catch (const std::exception &ex) {
                     throw std::runtime_error("DA::Pop() -> " + std::string(ex.what()));
                 }
             }
-
-            for (size_t i = index; i < size - 1; i++) {
-                arr[i] = arr[i + 1];
-            }
-            size--;
         }
 
         void Erase() {
-            delete[] arr;
+            std::destroy_n(arr, size);
+            Deallocate(arr, capacity);
             arr = nullptr;
 
             size = 0;
             capacity = 1;
+            min_capacity = 1;
             try {
-                arr = new T[capacity];
+                arr = Allocate(capacity);
             } catch (const std::bad_alloc &ex) {
                 throw std::runtime_error("DA::Erase() -> " + std::string(ex.what()));
             }
@@ -136,34 +249,18 @@ namespace DA {
 
         void Sort(bool (*cmp_lgreater)(T, T)) {
             if (cmp_lgreater) {
-                for (int i = 0; i < size - 1; i++) {
-                    for (int j = 0; j < size - i - 1; j++) {
-                        if (cmp_lgreater(arr[j], arr[j + 1])) {
-                            T temp = arr[j];
-                            arr[j] = arr[j + 1];
-                            arr[j + 1] = temp;
-                        }
-                    }
-                }
+                IS::Sort(arr, size, cmp_lgreater);
             } else if constexpr (std::is_arithmetic_v<T>) {
-                for (int i = 0; i < size - 1; i++) {
-                    for (int j = 0; j < size - i - 1; j++) {
-                        if (arr[j] > arr[j + 1]) {
-                            T temp = arr[j];
-                            arr[j] = arr[j + 1];
-                            arr[j + 1] = temp;
-                        }
-                    }
-                }
+                IS::Sort(arr, size, HC::LGreater<T>());
             } else {
                 throw std::runtime_error("DA::Sort(): T was not arithmetic and no cmp was provided");
             }
         }
 
         const T &operator[](size_t index) const {
-            if (index >= capacity) {
+            if (index >= size) {
                 throw std::out_of_range(
-                    "DA::Operator[]: index (" + std::to_string(index) + ") was greater or equal to array capacity (" +
+                    "DA::Operator[]: index (" + std::to_string(index) + ") was greater or equal to array size (" +
                     std::to_string(int(size)) + ")");
             }
 
@@ -171,9 +268,9 @@ namespace DA {
         }
 
         T &operator[](size_t index) {
-            if (index >= capacity) {
+            if (index >= size) {
                 throw std::out_of_range(
-                    "DA::Operator[]: index (" + std::to_string(index) + ") was greater or equal to array capacity (" +
+                    "DA::Operator[]: index (" + std::to_string(index) + ") was greater or equal to array size (" +
                     std::to_string(int(size)) + ")");
             }
 
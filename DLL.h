@@ -1,9 +1,104 @@
 #ifndef DLL_H
 #define DLL_H
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include "OC.h"
 
 namespace DLL {
-    template<typename T>
+    class NodeArena {
+        struct Slab {
+            Slab *next;
+            size_t capacity;
+        };
+
+        static constexpr size_t HEADER = (sizeof(Slab) + alignof(std::max_align_t) - 1) /
+                                         alignof(std::max_align_t) * alignof(std::max_align_t);
+
+        size_t slab_bytes;
+        Slab *slabs;
+        size_t used;
+        size_t bytes;
+
+    public:
+        NodeArena(size_t in_slab_bytes = 64 * 1024) {
+            slab_bytes = in_slab_bytes ? in_slab_bytes : 1;
+            slabs = nullptr;
+            used = 0;
+            bytes = 0;
+        }
+
+        NodeArena(const NodeArena &) = delete;
+
+        NodeArena &operator=(const NodeArena &) = delete;
+
+        ~NodeArena() {
+            Release();
+        }
+
+        size_t Bytes() const {
+            return bytes;
+        }
+
+        void *Allocate(size_t in_bytes, size_t align) {
+            size_t offset = (used + align - 1) / align * align;
+
+            if (!slabs || offset + in_bytes > slabs->capacity) {
+                size_t capacity = in_bytes > slab_bytes ? in_bytes : slab_bytes;
+                auto *slab = static_cast<Slab *>(::operator new(HEADER + capacity));
+                slab->next = slabs;
+                slab->capacity = capacity;
+                slabs = slab;
+                bytes += HEADER + capacity;
+                offset = 0;
+            }
+
+            used = offset + in_bytes;
+            return reinterpret_cast<unsigned char *>(slabs) + HEADER + offset;
+        }
+
+        void Release() {
+            while (slabs) {
+                Slab *next = slabs->next;
+                ::operator delete(slabs);
+                slabs = next;
+            }
+
+            used = 0;
+            bytes = 0;
+        }
+    };
+
+    struct HeapAllocator {
+        static constexpr bool RELEASES_NODES = true;
+
+        void *Allocate(size_t bytes, size_t) {
+            return ::operator new(bytes);
+        }
+
+        void Deallocate(void *ptr, size_t) {
+            ::operator delete(ptr);
+        }
+    };
+
+    struct ArenaAllocator {
+        static constexpr bool RELEASES_NODES = false;
+
+        NodeArena *arena = nullptr;
+
+        void *Allocate(size_t bytes, size_t align) {
+            if (!arena) { throw std::bad_alloc(); }
+            return arena->Allocate(bytes, align);
+        }
+
+        void Deallocate(void *, size_t) {
+        }
+    };
+
+    template<typename T, typename Alloc = HeapAllocator>
     class DoubLinList {
         struct Node {
             T data;
@@ -23,18 +118,269 @@ namespace DLL {
         size_t size;
         Node *head;
         Node *tail;
+        Alloc alloc;
+        mutable Node *cursor;
+        mutable size_t cursor_index;
+
+        Node *NodeAt(size_t index) const {
+            Node *temp = head;
+            size_t temp_index = 0;
+            size_t distance = index;
+
+            if (size - 1 - index < distance) {
+                temp = tail;
+                temp_index = size - 1;
+                distance = size - 1 - index;
+            }
+            if (cursor) {
+                size_t cursor_distance = index > cursor_index ? index - cursor_index : cursor_index - index;
+                if (cursor_distance < distance) {
+                    temp = cursor;
+                    temp_index = cursor_index;
+                }
+            }
+
+            for (; temp_index < index; temp_index++) {
+                temp = temp->next;
+            }
+            for (; temp_index > index; temp_index--) {
+                temp = temp->prev;
+            }
+
+            cursor = temp;
+            cursor_index = index;
+            return temp;
+        }
+
+        Node *NewNode(T data) {
+            void *mem = alloc.Allocate(sizeof(Node), alignof(Node));
+            OC::Add(OC::ALLOCATIONS);
+            return new(mem) Node(data);
+        }
+
+        void DeleteNode(Node *node) {
+            node->~Node();
+            alloc.Deallocate(node, sizeof(Node));
+        }
+
+        template<typename Cmp>
+        static Node *CutRun(Node *node, Cmp cmp_lgreater) {
+            while (node->next && !cmp_lgreater(node->data, node->next->data)) {
+                node = node->next;
+            }
+
+            Node *next = node->next;
+            node->next = nullptr;
+            return next;
+        }
+
+        template<typename Cmp>
+        static Node *MergeRuns(Node *run1, Node *run2, Cmp cmp_lgreater, Node *&merged_tail) {
+            Node *merged_head = nullptr;
+            Node **link = &merged_head;
+
+            while (run1 && run2) {
+                if (cmp_lgreater(run1->data, run2->data)) {
+                    *link = run2;
+                    run2 = run2->next;
+                } else {
+                    *link = run1;
+                    run1 = run1->next;
+                }
+                link = &(*link)->next;
+            }
+
+            *link = run1 ? run1 : run2;
+            while (*link) {
+                merged_tail = *link;
+                link = &(*link)->next;
+            }
+
+            return merged_head;
+        }
+
+        template<typename Cmp>
+        void InsertionSortData(Cmp cmp_lgreater) {
+            Node *current = head->next;
+
+            while (current != nullptr) {
+                T key = current->data;
+                Node *prev = current->prev;
+
+                while (prev != nullptr && cmp_lgreater(prev->data, key)) {
+                    prev->next->data = prev->data;
+                    OC::Add(OC::MOVES);
+                    prev = prev->prev;
+                }
+
+                if (prev == nullptr) {
+                    head->data = key;
+                } else {
+                    prev->next->data = key;
+                }
+                OC::Add(OC::MOVES);
+
+                current = current->next;
+            }
+        }
+
+        template<typename Cmp>
+        void MergeSortLinks(Cmp cmp_lgreater) {
+            if (size <= 1) {
+                return;
+            }
+
+            size_t merges;
+            do {
+                Node *rest = head;
+                Node *sorted_head = nullptr;
+                Node *sorted_tail = nullptr;
+                merges = 0;
+
+                while (rest) {
+                    Node *run1 = rest;
+                    rest = CutRun(run1, cmp_lgreater);
+                    Node *run2 = rest;
+                    if (rest) {
+                        rest = CutRun(run2, cmp_lgreater);
+                    }
+
+                    Node *merged_tail = nullptr;
+                    Node *merged_head = MergeRuns(run1, run2, cmp_lgreater, merged_tail);
+                    if (sorted_tail) {
+                        sorted_tail->next = merged_head;
+                    } else {
+                        sorted_head = merged_head;
+                    }
+                    sorted_tail = merged_tail;
+                    merges++;
+                }
+
+                head = sorted_head;
+                tail = sorted_tail;
+            } while (merges > 1);
+
+            cursor = nullptr;
+
+            Node *prev = nullptr;
+            for (Node *current = head; current; current = current->next) {
+                current->prev = prev;
+                prev = current;
+            }
+        }
 
     public:
-        DoubLinList() {
+        template<bool CONST>
+        class BasicIterator {
+            friend class DoubLinList;
+
+            Node *node;
+            const DoubLinList *list;
+
+            BasicIterator(Node *in_node, const DoubLinList *in_list) {
+                node = in_node;
+                list = in_list;
+            }
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<CONST, const T *, T *>;
+            using reference = std::conditional_t<CONST, const T &, T &>;
+
+            BasicIterator() {
+                node = nullptr;
+                list = nullptr;
+            }
+
+            operator BasicIterator<true>() const {
+                return BasicIterator<true>(node, list);
+            }
+
+            reference operator*() const {
+                return node->data;
+            }
+
+            pointer operator->() const {
+                return &node->data;
+            }
+
+            BasicIterator &operator++() {
+                node = node->next;
+                return *this;
+            }
+
+            BasicIterator operator++(int) {
+                BasicIterator temp = *this;
+                node = node->next;
+                return temp;
+            }
+
+            BasicIterator &operator--() {
+                node = node ? node->prev : list->tail;
+                return *this;
+            }
+
+            BasicIterator operator--(int) {
+                BasicIterator temp = *this;
+                node = node ? node->prev : list->tail;
+                return temp;
+            }
+
+            bool operator==(const BasicIterator &other) const {
+                return node == other.node;
+            }
+
+            bool operator!=(const BasicIterator &other) const {
+                return node != other.node;
+            }
+        };
+
+        using Iterator = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+
+        DoubLinList(Alloc in_alloc = Alloc()) : alloc(in_alloc) {
             size = 0;
             head = nullptr;
             tail = nullptr;
+            cursor = nullptr;
+            cursor_index = 0;
         }
 
+        DoubLinList(const DoubLinList &) = delete;
+
+        DoubLinList &operator=(const DoubLinList &) = delete;
+
         ~DoubLinList() {
             Erase();
         }
 
+        Iterator begin() {
+            return Iterator(head, this);
+        }
+
+        Iterator end() {
+            return Iterator(nullptr, this);
+        }
+
+        ConstIterator begin() const {
+            return ConstIterator(head, this);
+        }
+
+        ConstIterator end() const {
+            return ConstIterator(nullptr, this);
+        }
+
+        static constexpr size_t NodeBytes() {
+            return sizeof(Node);
+        }
+
+        void SetAllocator(Alloc in_alloc) {
+            if (size) { throw std::logic_error("DLL::SetAllocator(): list was not empty"); }
+            alloc = in_alloc;
+        }
+
         size_t Size() const {
             return size;
         }
@@ -54,7 +400,7 @@ namespace DLL {
         void PushFront(T data) {
             Node *node = nullptr;
             try {
-                node = new Node(data);
+                node = NewNode(data);
             } catch (const std::bad_alloc &ex) {
                 throw std::runtime_error("DLL::PushFront() -> " + std::string(ex.what()));
             }
@@ -69,12 +415,13 @@ namespace DLL {
             }
 
             size++;
+            cursor = nullptr;
         }
 
         void PushBack(T data) {
             Node *node = nullptr;
             try {
-                node = new Node(data);
+                node = NewNode(data);
             } catch (const std::bad_alloc &ex) {
                 throw std::runtime_error("DLL::PushBack() -> " + std::string(ex.what()));
             }
@@ -94,7 +441,7 @@ namespace DLL {
         void OrderPush(T data, bool (*cmp_equal)(T, T) = nullptr) {
             Node *node = nullptr;
             try {
-                node = new Node(data);
+                node = NewNode(data);
             } catch (const std::bad_alloc &ex) {
                 throw std::runtime_error("DLL::OrderPush() -> " + std::string(ex.what()));
             }
@@ -127,14 +474,14 @@ namespace DLL {
                     } catch (const std::exception &ex) {
                         throw std::runtime_error("DLL::OrderPush() -> " + std::string(ex.what()));
                     }
-                    delete node;
+                    DeleteNode(node);
                 } else if (temp == tail) {
                     try {
                         PushBack(data);
                     } catch (const std::exception &ex) {
                         throw std::runtime_error("DLL::OrderPush() -> " + std::string(ex.what()));
                     }
-                    delete node;
+                    DeleteNode(node);
                 } else {
                     node->next = temp->next;
                     temp->next->prev = node;
@@ -145,6 +492,7 @@ namespace DLL {
             }
 
             size++;
+            cursor = nullptr;
         }
 
         void Pop() {
@@ -159,16 +507,18 @@ namespace DLL {
             if (!size) { throw std::length_error("DLL::PopFront(): list was empty"); } else if (size > 1) {
                 Node *temp = head->next;
 
-                delete head;
+                DeleteNode(head);
                 head = temp;
                 head->prev = nullptr;
 
                 size--;
+                cursor = nullptr;
             } else {
-                delete head;
+                DeleteNode(head);
                 head = tail = nullptr;
 
                 size--;
+                cursor = nullptr;
             }
         }
 
@@ -176,16 +526,18 @@ namespace DLL {
             if (!size) { throw std::length_error("DLL::PopBack(): list was empty"); } else if (size > 1) {
                 Node *temp = tail->prev;
 
-                delete tail;
+                DeleteNode(tail);
                 tail = temp;
                 tail->next = nullptr;
 
                 size--;
+                cursor = nullptr;
             } else {
-                delete tail;
+                DeleteNode(tail);
                 head = tail = nullptr;
 
                 size--;
+                cursor = nullptr;
             }
         }
 
@@ -217,8 +569,9 @@ namespace DLL {
                     prev->next = next;
                     next->prev = prev;
 
-                    delete temp;
+                    DeleteNode(temp);
                     size--;
+                    cursor = nullptr;
                 }
 
                 return true;
@@ -230,14 +583,19 @@ namespace DLL {
         void Erase() {
             Node *temp;
 
+            if constexpr (!Alloc::RELEASES_NODES && std::is_trivially_destructible_v<T>) {
+                tail = nullptr;
+            }
+
             while (tail) {
                 temp = tail->prev;
-                delete tail;
+                DeleteNode(tail);
                 tail = temp;
             }
 
             head = nullptr;
             size = 0;
+            cursor = nullptr;
         }
 
         Node *Find(T data, bool (*cmp_equal)(T, T) = nullptr) const {
@@ -269,21 +627,7 @@ namespace DLL {
                     std::to_string(int(size)) + ")");
             }
 
-            Node *temp = nullptr;
-
-            if (index < size / 2) {
-                temp = head;
-                for (size_t i = 0; i < index; i++) {
-                    temp = temp->next;
-                }
-            } else {
-                temp = tail;
-                for (size_t i = size - 1; i > index; i--) {
-                    temp = temp->prev;
-                }
-            }
-
-            return temp->data;
+            return NodeAt(index)->data;
         }
 
         const T &operator[](size_t index) const {
@@ -293,21 +637,7 @@ namespace DLL {
                     std::to_string(int(size)) + ")");
             }
 
-            Node *temp = nullptr;
-
-            if (index < size / 2) {
-                temp = head;
-                for (size_t i = 0; i < index; i++) {
-                    temp = temp->next;
-                }
-            } else {
-                temp = tail;
-                for (size_t i = size - 1; i > index; i--) {
-                    temp = temp->prev;
-                }
-            }
-
-            return temp->data;
+            return NodeAt(index)->data;
         }
 
         std::string ToString(unsigned int limit = 0, std::string (*cmp_string)(T) = nullptr) const {
@@ -351,49 +681,29 @@ namespace DLL {
             }
 
             if (cmp_lgreater) {
-                Node *current = head->next;
-
-                while (current != nullptr) {
-                    T key = current->data;
-                    Node *prev = current->prev;
-
-                    while (prev != nullptr && cmp_lgreater(prev->data, key)) {
-                        prev->next->data = prev->data;
-                        prev = prev->prev;
-                    }
-
-                    if (prev == nullptr) {
-                        head->data = key;
-                    } else {
-                        prev->next->data = key;
-                    }
-
-                    current = current->next;
-                }
+                InsertionSortData(cmp_lgreater);
             } else if constexpr (std::is_arithmetic_v<T>) {
-                Node *current = head->next;
-
-                while (current != nullptr) {
-                    T key = current->data;
-                    Node *prev = current->prev;
-
-                    while (prev != nullptr && prev->data > key) {
-                        prev->next->data = prev->data;
-                        prev = prev->prev;
-                    }
-
-                    if (prev == nullptr) {
-                        head->data = key;
-                    } else {
-                        prev->next->data = key;
-                    }
-
-                    current = current->next;
-                }
+                InsertionSortData([](const T &data1, const T &data2) {
+                    OC::Add(OC::COMPARISONS);
+                    return data1 > data2;
+                });
             } else {
                 throw std::runtime_error("DLL::InsertionSort(): T was not arithmetic and no cmp was provided");
             }
         }
+
+        void MergeSort(bool (*cmp_lgreater)(T, T) = nullptr) {
+            if (cmp_lgreater) {
+                MergeSortLinks(cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                MergeSortLinks([](const T &data1, const T &data2) {
+                    OC::Add(OC::COMPARISONS);
+                    return data1 > data2;
+                });
+            } else {
+                throw std::runtime_error("DLL::MergeSort(): T was not arithmetic and no cmp was provided");
+            }
+        }
     };
 }
 
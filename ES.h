@@ -0,0 +1,304 @@
+#ifndef ES_H
+#define ES_H
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BH.h"
+#include "SAC.h"
+
+namespace ES {
+    constexpr size_t MIN_BUFFER_INTS = 1 << 14;
+    constexpr size_t MIN_MEMORY_BYTES = 4 * MIN_BUFFER_INTS * sizeof(int);
+
+    enum class RunSort {
+        COUNTING, HEAP
+    };
+
+    struct Stats {
+        size_t elements = 0;
+        size_t runs = 0;
+        size_t merge_passes = 0;
+        uint64_t bytes_read = 0;
+        uint64_t bytes_written = 0;
+        double run_seconds = 0;
+        double merge_seconds = 0;
+    };
+
+    struct Run {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    using File = std::unique_ptr<std::FILE, int (*)(std::FILE *)>;
+
+    struct Head {
+        int value;
+        size_t run;
+    };
+
+    inline bool HeadLGreater(Head head1, Head head2) {
+        return head1.value < head2.value;
+    }
+
+    class Reader {
+        std::FILE *file;
+        int *buffer;
+        size_t capacity;
+        size_t size;
+        size_t pos;
+        uint64_t next;
+        uint64_t remaining;
+        uint64_t *bytes_read;
+
+        bool Refill() {
+            size_t count = remaining < capacity ? static_cast<size_t>(remaining) : capacity;
+            if (!count) {
+                return false;
+            }
+
+            if (std::fseek(file, static_cast<long>(next * sizeof(int)), SEEK_SET) ||
+                std::fread(buffer, sizeof(int), count, file) != count) {
+                throw std::runtime_error("ES::Reader::Refill(): read failed");
+            }
+
+            *bytes_read += count * sizeof(int);
+            next += count;
+            remaining -= count;
+            size = count;
+            pos = 0;
+            return true;
+        }
+
+    public:
+        Reader(std::FILE *in_file, Run run, size_t in_capacity, uint64_t *in_bytes_read) {
+            file = in_file;
+            capacity = in_capacity ? in_capacity : 1;
+            buffer = new int[capacity];
+            size = 0;
+            pos = 0;
+            next = run.offset;
+            remaining = run.length;
+            bytes_read = in_bytes_read;
+        }
+
+        Reader(const Reader &) = delete;
+
+        Reader &operator=(const Reader &) = delete;
+
+        ~Reader() {
+            delete[] buffer;
+        }
+
+        bool Next(int &value) {
+            if (pos == size && !Refill()) {
+                return false;
+            }
+
+            value = buffer[pos++];
+            return true;
+        }
+    };
+
+    class Writer {
+        std::FILE *file;
+        int *buffer;
+        size_t capacity;
+        size_t size;
+        uint64_t *bytes_written;
+
+    public:
+        Writer(std::FILE *in_file, size_t in_capacity, uint64_t *in_bytes_written) {
+            file = in_file;
+            capacity = in_capacity ? in_capacity : 1;
+            buffer = new int[capacity];
+            size = 0;
+            bytes_written = in_bytes_written;
+        }
+
+        Writer(const Writer &) = delete;
+
+        Writer &operator=(const Writer &) = delete;
+
+        ~Writer() {
+            delete[] buffer;
+        }
+
+        void Put(int value) {
+            buffer[size++] = value;
+            if (size == capacity) {
+                Flush();
+            }
+        }
+
+        void Write(const int *data, size_t count) {
+            Flush();
+            if (std::fwrite(data, sizeof(int), count, file) != count) {
+                throw std::runtime_error("ES::Writer::Write(): write failed");
+            }
+            *bytes_written += count * sizeof(int);
+        }
+
+        void Flush() {
+            if (size && std::fwrite(buffer, sizeof(int), size, file) != size) {
+                throw std::runtime_error("ES::Writer::Flush(): write failed");
+            }
+            *bytes_written += size * sizeof(int);
+            size = 0;
+        }
+    };
+
+    inline void SortRun(int *run, size_t n, size_t scratch_bytes, RunSort run_sort) {
+        if (n < 2) {
+            return;
+        }
+
+        if (run_sort == RunSort::COUNTING) {
+            int min = run[0];
+            int max = run[0];
+            for (size_t i = 1; i < n; i++) {
+                if (run[i] < min) {
+                    min = run[i];
+                } else if (run[i] > max) {
+                    max = run[i];
+                }
+            }
+
+            size_t range = static_cast<size_t>(static_cast<int64_t>(max) - min) + 1;
+            if (range * sizeof(size_t) <= scratch_bytes) {
+                SAC::CompactCountingSort(run, n, min, max);
+                return;
+            }
+        }
+
+        SAC::SortingBinHeap<int> sbh(run, n);
+        sbh.Sort();
+    }
+
+    inline void MergeRuns(std::FILE *in_file, const Run *runs, size_t k, size_t buffer_ints, Writer &writer,
+                          Stats &stats) {
+        std::vector<std::unique_ptr<Reader> > readers(k);
+        BH::BinHeap<Head> heap(k);
+
+        for (size_t i = 0; i < k; i++) {
+            readers[i] = std::make_unique<Reader>(in_file, runs[i], buffer_ints, &stats.bytes_read);
+            int value;
+            if (readers[i]->Next(value)) {
+                heap.Push({value, i}, HeadLGreater);
+            }
+        }
+
+        while (heap.Size()) {
+            Head top = heap[0];
+            writer.Put(top.value);
+
+            int value;
+            if (readers[top.run]->Next(value)) {
+                heap.ReplaceTop({value, top.run}, HeadLGreater);
+            } else {
+                heap.Pop(0, HeadLGreater);
+            }
+        }
+    }
+
+    inline Stats ExternalSort(const std::string &input_path, const std::string &output_path, size_t memory_bytes,
+                              RunSort run_sort = RunSort::COUNTING) {
+        size_t budget_ints = memory_bytes / sizeof(int);
+        if (memory_bytes < MIN_MEMORY_BYTES) {
+            throw std::invalid_argument("ES::ExternalSort(): memory_bytes must be at least " +
+                                        std::to_string(MIN_MEMORY_BYTES));
+        }
+
+        uint64_t file_bytes = std::filesystem::file_size(input_path);
+        if (file_bytes % sizeof(int)) {
+            throw std::invalid_argument("ES::ExternalSort(): " + input_path + " is not a whole number of ints");
+        }
+
+        Stats stats;
+        stats.elements = file_bytes / sizeof(int);
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        File input(std::fopen(input_path.c_str(), "rb"), std::fclose);
+        File output(std::fopen(output_path.c_str(), "wb"), std::fclose);
+        File temp(std::tmpfile(), std::fclose);
+        if (!input || !output || !temp) {
+            throw std::runtime_error("ES::ExternalSort(): could not open " + input_path + ", " + output_path +
+                                     " or a temporary file");
+        }
+
+        size_t run_ints = run_sort == RunSort::COUNTING ? budget_ints / 2 : budget_ints;
+        std::unique_ptr<int[]> run(new int[run_ints]);
+        bool single_run = stats.elements <= run_ints;
+        Writer run_writer(single_run ? output.get() : temp.get(), MIN_BUFFER_INTS, &stats.bytes_written);
+
+        std::vector<Run> runs;
+        uint64_t offset = 0;
+        size_t length;
+        while ((length = std::fread(run.get(), sizeof(int), run_ints, input.get())) > 0) {
+            stats.bytes_read += length * sizeof(int);
+            SortRun(run.get(), length, (budget_ints - run_ints) * sizeof(int), run_sort);
+            run_writer.Write(run.get(), length);
+            runs.push_back({offset, length});
+            offset += length;
+        }
+        run_writer.Flush();
+        run.reset();
+
+        stats.runs = runs.size();
+        std::chrono::steady_clock::time_point runs_time = std::chrono::steady_clock::now();
+        stats.run_seconds = std::chrono::duration<double>(runs_time - start_time).count();
+
+        while (!single_run && runs.size() > 1) {
+            size_t fan_in = budget_ints / MIN_BUFFER_INTS - 1;
+            if (fan_in > runs.size()) {
+                fan_in = runs.size();
+            }
+            size_t buffer_ints = budget_ints / (fan_in + 1);
+            bool last_pass = runs.size() <= fan_in;
+
+            File next_temp(last_pass ? nullptr : std::tmpfile(), std::fclose);
+            if (!last_pass && !next_temp) {
+                throw std::runtime_error("ES::ExternalSort(): could not open a temporary file");
+            }
+            std::fflush(temp.get());
+
+            std::vector<Run> next_runs;
+            Writer writer(last_pass ? output.get() : next_temp.get(), buffer_ints, &stats.bytes_written);
+            uint64_t next_offset = 0;
+            for (size_t first = 0; first < runs.size(); first += fan_in) {
+                size_t k = runs.size() - first < fan_in ? runs.size() - first : fan_in;
+                uint64_t merged = 0;
+                for (size_t i = first; i < first + k; i++) {
+                    merged += runs[i].length;
+                }
+
+                MergeRuns(temp.get(), runs.data() + first, k, buffer_ints, writer, stats);
+                next_runs.push_back({next_offset, merged});
+                next_offset += merged;
+            }
+            writer.Flush();
+
+            temp = std::move(next_temp);
+            runs = next_runs;
+            stats.merge_passes++;
+
+            if (last_pass) {
+                break;
+            }
+        }
+
+        stats.merge_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runs_time).count();
+
+        if (std::fclose(output.release())) {
+            throw std::runtime_error("ES::ExternalSort(): could not finish writing " + output_path);
+        }
+
+        return stats;
+    }
+}
+
+#endif
@@ -0,0 +1,304 @@
+#ifndef GEN_H
+#define GEN_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TP.h"
+
+namespace GEN {
+    constexpr size_t BLOCK_SIZE = 1 << 14;
+
+    enum class Kind {
+        UNIFORM, SORTED, REVERSE, NEARLY_SORTED, SAWTOOTH, ORGAN_PIPE, FEW_UNIQUE, ZIPF, GAUSSIAN, ALL_EQUAL
+    };
+
+    struct Distribution {
+        std::string name;
+        Kind kind = Kind::UNIFORM;
+        double param = 0;
+    };
+
+    inline uint64_t Hash(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    class Rng {
+        uint64_t state;
+        double spare;
+        bool has_spare;
+
+    public:
+        explicit Rng(uint64_t seed) : state(seed), spare(0), has_spare(false) {
+        }
+
+        uint64_t Next() {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t x = state;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        uint64_t Below(uint64_t bound) {
+            return static_cast<uint64_t>((static_cast<unsigned __int128>(Next()) * bound) >> 64);
+        }
+
+        double Unit() {
+            return static_cast<double>((Next() >> 11) + 1) * 0x1.0p-53;
+        }
+
+        double Normal() {
+            if (has_spare) {
+                has_spare = false;
+                return spare;
+            }
+
+            double u, v, s;
+            do {
+                u = 2 * Unit() - 1;
+                v = 2 * Unit() - 1;
+                s = u * u + v * v;
+            } while (s >= 1 || s == 0);
+
+            double factor = std::sqrt(-2 * std::log(s) / s);
+            spare = v * factor;
+            has_spare = true;
+            return u * factor;
+        }
+    };
+
+    class Zipf {
+        double exponent;
+        double ranks;
+        double h_integral_x1;
+        double h_integral_n;
+        double s;
+
+        static double Helper1(double x) {
+            return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+        }
+
+        static double Helper2(double x) {
+            return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+        }
+
+        double H(double x) const {
+            return std::exp(-exponent * std::log(x));
+        }
+
+        double HIntegral(double x) const {
+            double log_x = std::log(x);
+            return Helper2((1 - exponent) * log_x) * log_x;
+        }
+
+        double HIntegralInverse(double x) const {
+            double t = std::max(-1.0, x * (1 - exponent));
+            return std::exp(Helper1(t) * x);
+        }
+
+    public:
+        Zipf(uint64_t in_ranks, double in_exponent) : exponent(in_exponent), ranks(static_cast<double>(in_ranks)) {
+            h_integral_x1 = HIntegral(1.5) - 1;
+            h_integral_n = HIntegral(ranks + 0.5);
+            s = 2 - HIntegralInverse(HIntegral(2.5) - H(2));
+        }
+
+        uint64_t operator()(Rng &rng) const {
+            while (true) {
+                double u = h_integral_n + rng.Unit() * (h_integral_x1 - h_integral_n);
+                double x = HIntegralInverse(u);
+                double k = std::clamp(std::floor(x + 0.5), 1.0, ranks);
+                if (k - x <= s || u >= HIntegral(k + 0.5) - H(k)) {
+                    return static_cast<uint64_t>(k) - 1;
+                }
+            }
+        }
+    };
+
+    inline Distribution Parse(const std::string &spec) {
+        static const std::vector<std::pair<std::string, std::pair<Kind, double> > > KINDS = {
+            {"uniform", {Kind::UNIFORM, 0}}, {"sorted", {Kind::SORTED, 0}}, {"reverse", {Kind::REVERSE, 0}},
+            {"nearly-sorted", {Kind::NEARLY_SORTED, 1}}, {"sawtooth", {Kind::SAWTOOTH, 16}},
+            {"organ-pipe", {Kind::ORGAN_PIPE, 0}}, {"few-unique", {Kind::FEW_UNIQUE, 16}}, {"zipf", {Kind::ZIPF, 1}},
+            {"gaussian", {Kind::GAUSSIAN, 8}}, {"all-equal", {Kind::ALL_EQUAL, 0}}
+        };
+
+        size_t colon = spec.find(':');
+        std::string name = spec.substr(0, colon);
+
+        for (const auto &[kind_name, kind]: KINDS) {
+            if (kind_name != name) {
+                continue;
+            }
+
+            Distribution dist{spec, kind.first, kind.second};
+            if (colon != std::string::npos) {
+                try {
+                    size_t used = 0;
+                    dist.param = std::stod(spec.substr(colon + 1), &used);
+                    if (used != spec.size() - colon - 1) {
+                        throw std::invalid_argument(spec);
+                    }
+                } catch (const std::exception &) {
+                    throw std::invalid_argument("GEN::Parse(): bad parameter in \"" + spec + "\"");
+                }
+            }
+
+            bool valid = true;
+            if (dist.kind == Kind::NEARLY_SORTED) {
+                valid = dist.param >= 0 && dist.param <= 100;
+            } else if (dist.kind == Kind::SAWTOOTH || dist.kind == Kind::FEW_UNIQUE || dist.kind == Kind::GAUSSIAN) {
+                valid = dist.param >= 1;
+            } else if (dist.kind == Kind::ZIPF) {
+                valid = dist.param > 0;
+            }
+            if (!valid) {
+                throw std::invalid_argument("GEN::Parse(): parameter out of range in \"" + spec + "\"");
+            }
+
+            return dist;
+        }
+
+        throw std::invalid_argument("GEN::Parse(): unknown distribution \"" + name + "\"");
+    }
+
+    template<typename F>
+    void FillBlocks(int *arr, size_t begin, size_t n, uint64_t seed, unsigned int threads, F &&fun) {
+        size_t first = begin / BLOCK_SIZE;
+        size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        threads = TP::Threads(threads);
+        if (threads > blocks) {
+            threads = blocks ? static_cast<unsigned int>(blocks) : 1;
+        }
+
+        TP::ParallelFor(threads, [&](unsigned int tid) {
+            size_t last = TP::ChunkBegin(blocks, threads, tid + 1);
+            for (size_t b = TP::ChunkBegin(blocks, threads, tid); b < last; b++) {
+                Rng rng(Hash(seed ^ Hash(first + b)));
+                size_t end = std::min(n, (b + 1) * BLOCK_SIZE);
+                for (size_t i = b * BLOCK_SIZE; i < end; i++) {
+                    arr[i] = fun(begin + i, rng);
+                }
+            }
+        });
+    }
+
+    inline int Scale(uint64_t i, uint64_t last, int m) {
+        return last ? static_cast<int>(i * static_cast<uint64_t>(m) / last) : m / 2;
+    }
+
+    inline void GenerateRange(int *arr, size_t total, size_t begin, size_t n, int m, const Distribution &dist,
+                              uint64_t seed, unsigned int threads = 0) {
+        if (!n) {
+            return;
+        }
+        if (m < 0) {
+            throw std::invalid_argument("GEN::GenerateRange(): m was negative");
+        }
+        if (begin % BLOCK_SIZE || (n % BLOCK_SIZE && begin + n != total) || begin + n > total) {
+            throw std::invalid_argument("GEN::GenerateRange(): [" + std::to_string(begin) + ", " +
+                                        std::to_string(begin + n) + ") is not a block-aligned range of " +
+                                        std::to_string(total));
+        }
+
+        switch (dist.kind) {
+            case Kind::UNIFORM:
+                FillBlocks(arr, begin, n, seed, threads, [m](size_t, Rng &rng) {
+                    return static_cast<int>(rng.Below(static_cast<uint64_t>(m) + 1));
+                });
+                break;
+            case Kind::SORTED:
+                FillBlocks(arr, begin, n, seed, threads, [total, m](size_t i, Rng &) {
+                    return Scale(i, total - 1, m);
+                });
+                break;
+            case Kind::REVERSE:
+                FillBlocks(arr, begin, n, seed, threads, [total, m](size_t i, Rng &) {
+                    return Scale(total - 1 - i, total - 1, m);
+                });
+                break;
+            case Kind::NEARLY_SORTED: {
+                FillBlocks(arr, begin, n, seed, threads, [total, m](size_t i, Rng &) {
+                    return Scale(i, total - 1, m);
+                });
+
+                size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+                unsigned int workers = std::min<size_t>(TP::Threads(threads), blocks);
+                TP::ParallelFor(workers, [&](unsigned int tid) {
+                    size_t last = TP::ChunkBegin(blocks, workers, tid + 1);
+                    for (size_t b = TP::ChunkBegin(blocks, workers, tid); b < last; b++) {
+                        Rng rng(Hash(~seed ^ Hash(begin / BLOCK_SIZE + b)));
+                        size_t block_begin = b * BLOCK_SIZE;
+                        size_t len = std::min(n, block_begin + BLOCK_SIZE) - block_begin;
+                        size_t swaps = static_cast<size_t>(std::llround(len * dist.param / 200));
+                        for (size_t s = 0; s < swaps; s++) {
+                            std::swap(arr[block_begin + rng.Below(len)], arr[block_begin + rng.Below(len)]);
+                        }
+                    }
+                });
+                break;
+            }
+            case Kind::SAWTOOTH: {
+                size_t teeth = std::min(total, static_cast<size_t>(dist.param));
+                size_t period = (total + teeth - 1) / teeth;
+                FillBlocks(arr, begin, n, seed, threads, [period, m](size_t i, Rng &) {
+                    return Scale(i % period, period - 1, m);
+                });
+                break;
+            }
+            case Kind::ORGAN_PIPE: {
+                size_t half = (total + 1) / 2;
+                FillBlocks(arr, begin, n, seed, threads, [total, half, m](size_t i, Rng &) {
+                    return Scale(i < half ? i : total - 1 - i, half - 1, m);
+                });
+                break;
+            }
+            case Kind::FEW_UNIQUE: {
+                uint64_t k = static_cast<uint64_t>(dist.param);
+                FillBlocks(arr, begin, n, seed, threads, [k, m](size_t, Rng &rng) {
+                    return Scale(rng.Below(k), k - 1, m);
+                });
+                break;
+            }
+            case Kind::ZIPF: {
+                Zipf zipf(static_cast<uint64_t>(m) + 1, dist.param);
+                FillBlocks(arr, begin, n, seed, threads, [&zipf](size_t, Rng &rng) {
+                    return static_cast<int>(zipf(rng));
+                });
+                break;
+            }
+            case Kind::GAUSSIAN: {
+                size_t clusters = static_cast<size_t>(dist.param);
+                std::vector<double> centers(clusters);
+                Rng rng_centers(Hash(~seed));
+                for (double &center: centers) {
+                    center = static_cast<double>(rng_centers.Below(static_cast<uint64_t>(m) + 1));
+                }
+                double sigma = std::max(1.0, m / (clusters * 32.0));
+
+                FillBlocks(arr, begin, n, seed, threads, [&centers, sigma, m](size_t, Rng &rng) {
+                    double value = centers[rng.Below(centers.size())] + sigma * rng.Normal();
+                    return static_cast<int>(std::clamp(std::llround(value), 0ll, static_cast<long long>(m)));
+                });
+                break;
+            }
+            case Kind::ALL_EQUAL:
+                FillBlocks(arr, begin, n, seed, threads, [m](size_t, Rng &) { return m / 2; });
+                break;
+        }
+    }
+
+    inline void Generate(int *arr, size_t n, int m, const Distribution &dist, uint64_t seed,
+                         unsigned int threads = 0) {
+        GenerateRange(arr, n, 0, n, m, dist, seed, threads);
+    }
+}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef HC_H
+#define HC_H
+#include <cstddef>
+#include <utility>
+#include "OC.h"
+
+namespace HC {
+    template<typename T>
+    struct LGreater {
+        bool operator()(const T &data1, const T &data2) const {
+            OC::Add(OC::COMPARISONS);
+            return data1 > data2;
+        }
+    };
+
+    template<typename Cmp>
+    struct CountingCmp {
+        Cmp cmp;
+        size_t *counter;
+
+        template<typename T>
+        bool operator()(const T &data1, const T &data2) const {
+            (*counter)++;
+            return cmp(data1, data2);
+        }
+    };
+
+    template<typename T, typename Cmp>
+    void SiftUp(T *arr, size_t index, Cmp cmp_lgreater) {
+        T data = std::move(arr[index]);
+
+        while (index) {
+            size_t parent = (index - 1) / 2;
+            if (!cmp_lgreater(data, arr[parent])) {
+                break;
+            }
+            arr[index] = std::move(arr[parent]);
+            OC::Add(OC::MOVES);
+            index = parent;
+        }
+
+        arr[index] = std::move(data);
+        OC::Add(OC::MOVES);
+    }
+
+    template<typename T, typename Cmp>
+    void SiftDown(T *arr, size_t size, size_t index, Cmp cmp_lgreater) {
+        T data = std::move(arr[index]);
+
+        size_t child = 2 * index + 1;
+        while (child < size) {
+            if (child + 1 < size && cmp_lgreater(arr[child + 1], arr[child])) {
+                child++;
+            }
+            if (!cmp_lgreater(arr[child], data)) {
+                break;
+            }
+            arr[index] = std::move(arr[child]);
+            OC::Add(OC::MOVES);
+            index = child;
+            child = 2 * index + 1;
+        }
+
+        arr[index] = std::move(data);
+        OC::Add(OC::MOVES);
+    }
+
+    template<typename T, typename Cmp>
+    void BottomUpSiftDown(T *arr, size_t size, size_t index, Cmp cmp_lgreater) {
+        T data = std::move(arr[index]);
+        size_t top = index;
+
+        size_t child = 2 * index + 1;
+        while (child < size) {
+            if (child + 1 < size && cmp_lgreater(arr[child + 1], arr[child])) {
+                child++;
+            }
+            arr[index] = std::move(arr[child]);
+            OC::Add(OC::MOVES);
+            index = child;
+            child = 2 * index + 1;
+        }
+
+        while (index > top) {
+            size_t parent = (index - 1) / 2;
+            if (!cmp_lgreater(data, arr[parent])) {
+                break;
+            }
+            arr[index] = std::move(arr[parent]);
+            OC::Add(OC::MOVES);
+            index = parent;
+        }
+
+        arr[index] = std::move(data);
+        OC::Add(OC::MOVES);
+    }
+
+    template<typename T, typename Cmp>
+    void MakeHeap(T *arr, size_t size, Cmp cmp_lgreater) {
+        for (size_t i = size / 2; i > 0; i--) {
+            SiftDown(arr, size, i - 1, cmp_lgreater);
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void MakeHeapByInsertion(T *arr, size_t size, Cmp cmp_lgreater) {
+        for (size_t i = 1; i < size; i++) {
+            SiftUp(arr, i, cmp_lgreater);
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void SortHeap(T *arr, size_t size, Cmp cmp_lgreater) {
+        for (size_t i = size; i > 1; i--) {
+            std::swap(arr[0], arr[i - 1]);
+            OC::Add(OC::MOVES, 2);
+            SiftDown(arr, i - 1, 0, cmp_lgreater);
+        }
+    }
+
+    template<size_t ARITY, typename T, typename Cmp>
+    void DarySiftDown(T *arr, size_t size, size_t index, Cmp cmp_lgreater) {
+        T data = std::move(arr[index]);
+
+        size_t first = ARITY * index + 1;
+        while (first < size) {
+            size_t last = first + ARITY < size ? first + ARITY : size;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; child++) {
+                if (cmp_lgreater(arr[child], arr[best])) {
+                    best = child;
+                }
+            }
+            if (!cmp_lgreater(arr[best], data)) {
+                break;
+            }
+            arr[index] = std::move(arr[best]);
+            OC::Add(OC::MOVES);
+            index = best;
+            first = ARITY * index + 1;
+        }
+
+        arr[index] = std::move(data);
+        OC::Add(OC::MOVES);
+    }
+
+    template<size_t ARITY, typename T, typename Cmp>
+    void DarySiftUp(T *arr, size_t index, Cmp cmp_lgreater) {
+        T data = std::move(arr[index]);
+
+        while (index) {
+            size_t parent = (index - 1) / ARITY;
+            if (!cmp_lgreater(data, arr[parent])) {
+                break;
+            }
+            arr[index] = std::move(arr[parent]);
+            OC::Add(OC::MOVES);
+            index = parent;
+        }
+
+        arr[index] = std::move(data);
+        OC::Add(OC::MOVES);
+    }
+
+    template<size_t ARITY, typename T, typename Cmp>
+    void MakeDaryHeap(T *arr, size_t size, Cmp cmp_lgreater) {
+        for (size_t i = (size + ARITY - 2) / ARITY; i > 0; i--) {
+            DarySiftDown<ARITY>(arr, size, i - 1, cmp_lgreater);
+        }
+    }
+
+    template<size_t ARITY, typename T, typename Cmp>
+    void SortDaryHeap(T *arr, size_t size, Cmp cmp_lgreater) {
+        for (size_t i = size; i > 1; i--) {
+            std::swap(arr[0], arr[i - 1]);
+            OC::Add(OC::MOVES, 2);
+            DarySiftDown<ARITY>(arr, i - 1, 0, cmp_lgreater);
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void BottomUpSortHeap(T *arr, size_t size, Cmp cmp_lgreater) {
+        for (size_t i = size; i > 1; i--) {
+            std::swap(arr[0], arr[i - 1]);
+            OC::Add(OC::MOVES, 2);
+            BottomUpSiftDown(arr, i - 1, 0, cmp_lgreater);
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void HeapSort(T *arr, size_t size, Cmp cmp_lgreater) {
+        MakeHeap(arr, size, cmp_lgreater);
+        SortHeap(arr, size, cmp_lgreater);
+    }
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef IS_H
+#define IS_H
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "HC.h"
+#include "SN.h"
+
+namespace IS {
+    constexpr size_t INSERTION_THRESHOLD = 24;
+    constexpr size_t NINTHER_THRESHOLD = 128;
+    constexpr size_t PARTIAL_INSERTION_LIMIT = 8;
+
+    template<typename T, typename Cmp>
+    void InsertionSort(T *arr, size_t n, Cmp cmp_lgreater) {
+        for (size_t i = 1; i < n; i++) {
+            if (cmp_lgreater(arr[i - 1], arr[i])) {
+                T key = std::move(arr[i]);
+                size_t j = i;
+                do {
+                    arr[j] = std::move(arr[j - 1]);
+                    OC::Add(OC::MOVES);
+                    j--;
+                } while (j > 0 && cmp_lgreater(arr[j - 1], key));
+                arr[j] = std::move(key);
+                OC::Add(OC::MOVES);
+            }
+        }
+    }
+
+    template<typename T, typename Cmp>
+    bool PartialInsertionSort(T *arr, size_t n, Cmp cmp_lgreater) {
+        size_t moves = 0;
+
+        for (size_t i = 1; i < n; i++) {
+            if (moves > PARTIAL_INSERTION_LIMIT) {
+                return false;
+            }
+
+            if (cmp_lgreater(arr[i - 1], arr[i])) {
+                T key = std::move(arr[i]);
+                size_t j = i;
+                do {
+                    arr[j] = std::move(arr[j - 1]);
+                    OC::Add(OC::MOVES);
+                    j--;
+                } while (j > 0 && cmp_lgreater(arr[j - 1], key));
+                arr[j] = std::move(key);
+                OC::Add(OC::MOVES);
+                moves += i - j;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T, typename Cmp>
+    void SortTwo(T &data1, T &data2, Cmp cmp_lgreater) {
+        if (cmp_lgreater(data1, data2)) {
+            std::swap(data1, data2);
+            OC::Add(OC::MOVES, 2);
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void SortThree(T &data1, T &data2, T &data3, Cmp cmp_lgreater) {
+        SortTwo(data1, data2, cmp_lgreater);
+        SortTwo(data2, data3, cmp_lgreater);
+        SortTwo(data1, data2, cmp_lgreater);
+    }
+
+    template<typename T, typename Cmp>
+    size_t PartitionRight(T *arr, size_t n, Cmp cmp_lgreater, bool &already_partitioned) {
+        T pivot = std::move(arr[0]);
+        size_t first = 0;
+        size_t last = n;
+
+        while (cmp_lgreater(pivot, arr[++first])) {
+        }
+
+        if (first == 1) {
+            while (first < last && !cmp_lgreater(pivot, arr[--last])) {
+            }
+        } else {
+            while (!cmp_lgreater(pivot, arr[--last])) {
+            }
+        }
+
+        already_partitioned = first >= last;
+
+        while (first < last) {
+            std::swap(arr[first], arr[last]);
+            OC::Add(OC::MOVES, 2);
+            while (cmp_lgreater(pivot, arr[++first])) {
+            }
+            while (!cmp_lgreater(pivot, arr[--last])) {
+            }
+        }
+
+        size_t pivot_index = first - 1;
+        arr[0] = std::move(arr[pivot_index]);
+        arr[pivot_index] = std::move(pivot);
+        OC::Add(OC::MOVES, 2);
+
+        return pivot_index;
+    }
+
+    template<typename T, typename Cmp>
+    size_t PartitionLeft(T *arr, size_t n, Cmp cmp_lgreater) {
+        T pivot = std::move(arr[0]);
+        size_t first = 0;
+        size_t last = n;
+
+        while (cmp_lgreater(arr[--last], pivot)) {
+        }
+
+        if (last + 1 == n) {
+            while (first < last && !cmp_lgreater(arr[++first], pivot)) {
+            }
+        } else {
+            while (!cmp_lgreater(arr[++first], pivot)) {
+            }
+        }
+
+        while (first < last) {
+            std::swap(arr[first], arr[last]);
+            OC::Add(OC::MOVES, 2);
+            while (cmp_lgreater(arr[--last], pivot)) {
+            }
+            while (!cmp_lgreater(arr[++first], pivot)) {
+            }
+        }
+
+        arr[0] = std::move(arr[last]);
+        arr[last] = std::move(pivot);
+        OC::Add(OC::MOVES, 2);
+
+        return last;
+    }
+
+    template<typename T>
+    void BreakPatterns(T *arr, size_t n, size_t pivot_index) {
+        size_t left_size = pivot_index;
+        size_t right_size = n - pivot_index - 1;
+
+        if (left_size >= INSERTION_THRESHOLD) {
+            std::swap(arr[0], arr[left_size / 4]);
+            std::swap(arr[pivot_index - 1], arr[pivot_index - left_size / 4]);
+            if (left_size > NINTHER_THRESHOLD) {
+                std::swap(arr[1], arr[left_size / 4 + 1]);
+                std::swap(arr[2], arr[left_size / 4 + 2]);
+                std::swap(arr[pivot_index - 2], arr[pivot_index - (left_size / 4 + 1)]);
+                std::swap(arr[pivot_index - 3], arr[pivot_index - (left_size / 4 + 2)]);
+            }
+        }
+
+        if (right_size >= INSERTION_THRESHOLD) {
+            std::swap(arr[pivot_index + 1], arr[pivot_index + 1 + right_size / 4]);
+            std::swap(arr[n - 1], arr[n - right_size / 4]);
+            if (right_size > NINTHER_THRESHOLD) {
+                std::swap(arr[pivot_index + 2], arr[pivot_index + 2 + right_size / 4]);
+                std::swap(arr[pivot_index + 3], arr[pivot_index + 3 + right_size / 4]);
+                std::swap(arr[n - 2], arr[n - (1 + right_size / 4)]);
+                std::swap(arr[n - 3], arr[n - (2 + right_size / 4)]);
+            }
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void SortLoop(T *arr, size_t n, Cmp cmp_lgreater, size_t bad_allowed, bool leftmost) {
+        while (n >= INSERTION_THRESHOLD) {
+            size_t half = n / 2;
+            if (n > NINTHER_THRESHOLD) {
+                SortThree(arr[0], arr[half], arr[n - 1], cmp_lgreater);
+                SortThree(arr[1], arr[half - 1], arr[n - 2], cmp_lgreater);
+                SortThree(arr[2], arr[half + 1], arr[n - 3], cmp_lgreater);
+                SortThree(arr[half - 1], arr[half], arr[half + 1], cmp_lgreater);
+                std::swap(arr[0], arr[half]);
+            } else {
+                SortThree(arr[half], arr[0], arr[n - 1], cmp_lgreater);
+            }
+
+            if (!leftmost && !cmp_lgreater(arr[0], arr[-1])) {
+                size_t pivot_index = PartitionLeft(arr, n, cmp_lgreater);
+                arr += pivot_index + 1;
+                n -= pivot_index + 1;
+                continue;
+            }
+
+            bool already_partitioned = false;
+            size_t pivot_index = PartitionRight(arr, n, cmp_lgreater, already_partitioned);
+            size_t left_size = pivot_index;
+            size_t right_size = n - pivot_index - 1;
+
+            if (left_size < n / 8 || right_size < n / 8) {
+                if (--bad_allowed == 0) {
+                    HC::HeapSort(arr, n, cmp_lgreater);
+                    return;
+                }
+                BreakPatterns(arr, n, pivot_index);
+            } else if (already_partitioned && PartialInsertionSort(arr, left_size, cmp_lgreater) &&
+                       PartialInsertionSort(arr + pivot_index + 1, right_size, cmp_lgreater)) {
+                return;
+            }
+
+            SortLoop(arr, left_size, cmp_lgreater, bad_allowed, leftmost);
+            arr += pivot_index + 1;
+            n = right_size;
+            leftmost = false;
+        }
+
+        if constexpr (SN::SORTABLE<T> && std::is_same_v<Cmp, HC::LGreater<T> >) {
+            if (n >= SN::MIN_SIZE) {
+                SN::Sort(arr, n);
+                return;
+            }
+        }
+        InsertionSort(arr, n, cmp_lgreater);
+    }
+
+    template<typename T, typename Cmp>
+    void Sort(T *arr, size_t n, Cmp cmp_lgreater) {
+        size_t depth_limit = 1;
+        for (size_t i = n; i > 1; i >>= 1) {
+            depth_limit++;
+        }
+
+        SortLoop(arr, n, cmp_lgreater, depth_limit, true);
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef LT_H
+#define LT_H
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "HC.h"
+#include "OC.h"
+
+namespace LT {
+    template<typename T, typename Cmp>
+    class LoserTree {
+        const T **pos;
+        const T **end;
+        size_t *losers;
+        size_t k;
+        size_t winner;
+        size_t remaining;
+        Cmp cmp_lgreater;
+
+        bool Beats(size_t run1, size_t run2) const {
+            if (pos[run1] == end[run1]) {
+                return false;
+            }
+            if (pos[run2] == end[run2]) {
+                return true;
+            }
+
+            return run1 < run2 ? !cmp_lgreater(*pos[run1], *pos[run2]) : cmp_lgreater(*pos[run2], *pos[run1]);
+        }
+
+        void Replay() {
+            size_t run = winner;
+            for (size_t node = (run + k) / 2; node > 0; node /= 2) {
+                if (Beats(losers[node], run)) {
+                    size_t temp = losers[node];
+                    losers[node] = run;
+                    run = temp;
+                }
+            }
+            winner = run;
+        }
+
+    public:
+        LoserTree(const T *const *runs, const size_t *sizes, size_t in_k, Cmp in_cmp_lgreater)
+            : cmp_lgreater(in_cmp_lgreater) {
+            if (!in_k) {
+                throw std::invalid_argument("LT::LoserTree(): k was 0");
+            }
+
+            k = in_k;
+            remaining = 0;
+            pos = new const T *[k];
+            end = new const T *[k];
+            losers = new size_t[k];
+
+            size_t *winners = new size_t[2 * k];
+            for (size_t i = 0; i < k; i++) {
+                pos[i] = runs[i];
+                end[i] = runs[i] + sizes[i];
+                winners[k + i] = i;
+                remaining += sizes[i];
+            }
+            for (size_t node = k - 1; node > 0; node--) {
+                size_t left = winners[2 * node];
+                size_t right = winners[2 * node + 1];
+                bool left_wins = Beats(left, right);
+                winners[node] = left_wins ? left : right;
+                losers[node] = left_wins ? right : left;
+            }
+            winner = k > 1 ? winners[1] : 0;
+            delete[] winners;
+        }
+
+        LoserTree(const LoserTree &) = delete;
+
+        LoserTree &operator=(const LoserTree &) = delete;
+
+        ~LoserTree() {
+            delete[] pos;
+            delete[] end;
+            delete[] losers;
+        }
+
+        size_t Size() const {
+            return remaining;
+        }
+
+        size_t Run() const {
+            return winner;
+        }
+
+        T Poll() {
+            if (!remaining) { throw std::length_error("LT::LoserTree::Poll(): tree was empty"); }
+
+            T data = *pos[winner]++;
+            remaining--;
+            Replay();
+
+            return data;
+        }
+
+        size_t Merge(T *out_arr) {
+            size_t n = remaining;
+            for (size_t i = 0; i < n; i++) {
+                out_arr[i] = *pos[winner]++;
+                Replay();
+            }
+            remaining = 0;
+            OC::Add(OC::MOVES, n);
+
+            return n;
+        }
+    };
+
+    template<typename T, typename Cmp>
+    size_t Merge(const T *const *runs, const size_t *sizes, size_t k, T *out_arr, Cmp cmp_lgreater) {
+        if (!k) {
+            return 0;
+        }
+
+        LoserTree<T, Cmp> tree(runs, sizes, k, cmp_lgreater);
+        return tree.Merge(out_arr);
+    }
+
+    template<typename T>
+    size_t Merge(const T *const *runs, const size_t *sizes, size_t k, T *out_arr,
+                 bool (*cmp_lgreater)(T, T) = nullptr) {
+        if (cmp_lgreater) {
+            return Merge<T, bool (*)(T, T)>(runs, sizes, k, out_arr, cmp_lgreater);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return Merge<T, HC::LGreater<T> >(runs, sizes, k, out_arr, HC::LGreater<T>());
+        } else {
+            throw std::runtime_error("LT::Merge(): T was not arithmetic and no cmp was provided");
+        }
+    }
+}
+
+#endif
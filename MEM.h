@@ -0,0 +1,170 @@
+#ifndef MEM_H
+#define MEM_H
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace MEM {
+    constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    struct Stats {
+        uint64_t allocated_bytes;
+        uint64_t allocations;
+        uint64_t peak_bytes;
+    };
+
+    inline std::atomic<uint64_t> allocated_bytes = 0;
+    inline std::atomic<uint64_t> allocations = 0;
+    inline std::atomic<int64_t> live_bytes = 0;
+    inline std::atomic<int64_t> peak_bytes = 0;
+    inline std::atomic<int64_t> base_bytes = 0;
+
+    inline void OnAllocate(size_t bytes) {
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t live = live_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + bytes;
+        int64_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    inline void OnDeallocate(size_t bytes) {
+        live_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    inline void Reset() {
+        allocated_bytes.store(0, std::memory_order_relaxed);
+        allocations.store(0, std::memory_order_relaxed);
+        int64_t live = live_bytes.load(std::memory_order_relaxed);
+        base_bytes.store(live, std::memory_order_relaxed);
+        peak_bytes.store(live, std::memory_order_relaxed);
+    }
+
+    inline Stats Read() {
+        int64_t peak = peak_bytes.load(std::memory_order_relaxed) - base_bytes.load(std::memory_order_relaxed);
+        return {
+            allocated_bytes.load(std::memory_order_relaxed), allocations.load(std::memory_order_relaxed),
+            static_cast<uint64_t>(peak > 0 ? peak : 0)
+        };
+    }
+
+    inline void *Allocate(size_t bytes, size_t align) {
+        size_t offset = align > HEADER_SIZE ? align : HEADER_SIZE;
+        size_t total = offset + bytes;
+        void *block = offset == HEADER_SIZE
+                          ? std::malloc(total)
+                          : std::aligned_alloc(offset, (total + offset - 1) / offset * offset);
+        if (!block) {
+            return nullptr;
+        }
+
+        char *mem = static_cast<char *>(block) + offset;
+        std::memcpy(mem - sizeof(size_t), &bytes, sizeof(size_t));
+        OnAllocate(bytes);
+
+        return mem;
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+    inline void Deallocate(void *mem, size_t align) {
+        if (!mem) {
+            return;
+        }
+
+        size_t offset = align > HEADER_SIZE ? align : HEADER_SIZE;
+        size_t bytes;
+        std::memcpy(&bytes, static_cast<char *>(mem) - sizeof(size_t), sizeof(size_t));
+        OnDeallocate(bytes);
+        std::free(static_cast<char *>(mem) - offset);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    inline size_t ResidentBytes() {
+#ifdef __linux__
+        int fd = open("/proc/self/statm", O_RDONLY);
+        if (fd < 0) {
+            return 0;
+        }
+
+        char buffer[128];
+        ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+        close(fd);
+        if (length <= 0) {
+            return 0;
+        }
+        buffer[length] = '\0';
+
+        char *text = buffer;
+        std::strtoull(text, &text, 10);
+        return std::strtoull(text, nullptr, 10) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    class RssSampler {
+        std::atomic<bool> running;
+        std::atomic<size_t> peak;
+        size_t base;
+        std::thread sampler;
+
+    public:
+        RssSampler() : running(false), peak(0), base(0) {
+        }
+
+        RssSampler(const RssSampler &) = delete;
+
+        RssSampler &operator=(const RssSampler &) = delete;
+
+        ~RssSampler() {
+            Stop();
+        }
+
+        void Start() {
+            base = ResidentBytes();
+            peak = base;
+            running = true;
+            sampler = std::thread([this]() {
+                while (running.load(std::memory_order_relaxed)) {
+                    size_t rss = ResidentBytes();
+                    if (rss > peak.load(std::memory_order_relaxed)) {
+                        peak.store(rss, std::memory_order_relaxed);
+                    }
+                    std::this_thread::sleep_for(std::chrono::microseconds(500));
+                }
+            });
+        }
+
+        size_t Stop() {
+            if (sampler.joinable()) {
+                running = false;
+                sampler.join();
+
+                size_t rss = ResidentBytes();
+                if (rss > peak) {
+                    peak = rss;
+                }
+            }
+
+            return peak > base ? peak - base : 0;
+        }
+    };
+}
+
+#endif
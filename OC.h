@@ -0,0 +1,36 @@
+#ifndef OC_H
+#define OC_H
+#include <atomic>
+#include <cstdint>
+
+namespace OC {
+#ifdef SAC_COUNT_OPS
+    constexpr bool ENABLED = true;
+#else
+    constexpr bool ENABLED = false;
+#endif
+
+    enum Counter {
+        COMPARISONS, MOVES, ALLOCATIONS, COUNTERS
+    };
+
+    inline std::atomic<uint64_t> counts[COUNTERS] = {};
+
+    inline void Add(Counter counter, uint64_t amount = 1) {
+        if constexpr (ENABLED) {
+            counts[counter].fetch_add(amount, std::memory_order_relaxed);
+        }
+    }
+
+    inline void Reset() {
+        for (std::atomic<uint64_t> &count: counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    inline uint64_t Get(Counter counter) {
+        return counts[counter].load(std::memory_order_relaxed);
+    }
+}
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef PC_H
+#define PC_H
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace PC {
+    struct Event {
+        const char *name;
+        uint32_t type;
+        uint64_t config;
+    };
+
+    class Counters {
+        struct Counter {
+            const char *name;
+            int fd;
+            double total;
+        };
+
+        std::vector<Counter> counters;
+        std::vector<std::string> missing;
+        size_t runs;
+
+    public:
+        Counters() {
+            runs = 0;
+#ifndef __linux__
+            missing.emplace_back("all (perf_event_open requires Linux)");
+#else
+            constexpr uint64_t READ_MISS = PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+            const Event EVENTS[] = {
+                {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {"l1d-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | READ_MISS},
+                {"llc-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | READ_MISS},
+                {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {"dtlb-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | READ_MISS},
+                {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            };
+
+            for (const Event &event: EVENTS) {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                attr.type = event.type;
+                attr.config = event.config;
+                attr.disabled = 1;
+                attr.inherit = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if (fd >= 0) {
+                    counters.push_back({event.name, fd, 0});
+                } else {
+                    missing.emplace_back(event.name);
+                }
+            }
+#endif
+        }
+
+        Counters(const Counters &) = delete;
+
+        Counters &operator=(const Counters &) = delete;
+
+        ~Counters() {
+#ifdef __linux__
+            for (Counter &counter: counters) {
+                close(counter.fd);
+            }
+#endif
+        }
+
+        bool Available() const {
+            return !counters.empty();
+        }
+
+        const std::vector<std::string> &Missing() const {
+            return missing;
+        }
+
+        void Start() {
+#ifdef __linux__
+            for (Counter &counter: counters) {
+                ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+            }
+            for (Counter &counter: counters) {
+                ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        void Stop(bool record = true) {
+#ifdef __linux__
+            for (Counter &counter: counters) {
+                ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+            if (!record) {
+                return;
+            }
+
+            for (Counter &counter: counters) {
+                uint64_t values[3] = {0, 0, 0};
+                if (read(counter.fd, values, sizeof(values)) == sizeof(values) && values[2]) {
+                    counter.total += static_cast<double>(values[0]) * values[1] / values[2];
+                }
+            }
+            runs++;
+#endif
+        }
+
+        std::vector<std::pair<std::string, double> > Averages() const {
+            std::vector<std::pair<std::string, double> > averages;
+
+            for (const Counter &counter: counters) {
+                averages.emplace_back(counter.name, runs ? counter.total / runs : 0);
+            }
+
+            return averages;
+        }
+    };
+}
+
+#endif
@@ -1,40 +1,221 @@
 #ifndef SAC_H
 #define SAC_H
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "BH.h"
 #include "DLL.h"
+#include "IS.h"
+#include "OC.h"
+#include "SN.h"
+#include "TP.h"
 
 namespace SAC {
+    constexpr size_t LIST_MERGE_THRESHOLD = 32;
+    constexpr size_t COUNTING_RANGE_FACTOR = 4;
+    constexpr size_t PACKED_RADIX_THRESHOLD = 256;
+    constexpr size_t SAMPLE_SORT_THRESHOLD = 1 << 14;
+    constexpr size_t SAMPLE_OVERSAMPLING = 16;
+    constexpr size_t MAX_SAMPLE_BUCKETS = 256;
+    constexpr size_t FLAT_BUCKET_BLOCKS_PER_THREAD = 64;
+
     template<typename T>
     class SortingBinHeap : public BH::BinHeap<T> {
-    public:
-        SortingBinHeap(T *arr, size_t n, bool top_down = false, bool (*cmp_lgreater)(T, T) = nullptr) : BH::BinHeap<T>(
-            n) {
+        void Adopt(T *arr, size_t n) {
+            this->Deallocate(this->arr, this->capacity);
             this->arr = arr;
             this->size = n;
-            this->capacity = n + 1;
+            this->capacity = n;
+        }
+
+        template<typename Cmp>
+        size_t SortBottomUp(Cmp cmp_lgreater) {
+            size_t comparisons = 0;
+            HC::BottomUpSortHeap(this->arr, this->size, HC::CountingCmp<Cmp>{cmp_lgreater, &comparisons});
+            return comparisons;
+        }
+
+        template<size_t ARITY, typename Cmp>
+        static void SortWithDaryHeap(T *arr, size_t n, Cmp cmp_lgreater) {
+            BH::DaryHeap<T, ARITY> heap(arr, n, cmp_lgreater);
+            heap.Sort(cmp_lgreater);
+            heap.CopyTo(arr);
+        }
+
+    public:
+        SortingBinHeap(T *arr, size_t n, bool top_down = false, bool (*cmp_lgreater)(T, T) = nullptr) : BH::BinHeap<T>(
+            1) {
+            Adopt(arr, n);
+
+            if (cmp_lgreater) {
+                Heapify(top_down, cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                Heapify(top_down, HC::LGreater<T>());
+            } else {
+                throw std::runtime_error("SAC::SortingBinHeap(): T was not arithmetic and no cmp was provided");
+            }
+        }
+
+        template<typename Cmp>
+        SortingBinHeap(T *arr, size_t n, bool top_down, Cmp cmp_lgreater) : BH::BinHeap<T>(1) {
+            Adopt(arr, n);
+            Heapify(top_down, cmp_lgreater);
+        }
+
+        ~SortingBinHeap() {
+            this->arr = nullptr;
+            this->size = 0;
+            this->capacity = 0;
+        }
 
+        template<typename Cmp>
+        void Heapify(bool top_down, Cmp cmp_lgreater) {
             if (top_down) {
-                for (size_t i = this->NodeParentIndex(n - 1); i != -1; i--) {
-                    this->HeapifyDown(i, cmp_lgreater);
-                }
+                HC::MakeHeap(this->arr, this->size, cmp_lgreater);
             } else {
-                for (size_t i = 0; i < this->Size(); i++) {
-                    this->HeapifyUp(i, cmp_lgreater);
-                }
+                HC::MakeHeapByInsertion(this->arr, this->size, cmp_lgreater);
             }
         }
 
         void Sort(bool (*cmp_lgreater)(T, T) = nullptr) {
-            size_t temp_size = this->Size();
-            for (size_t i = this->size - 1; i > 0; i--) {
-                this->Swap(0, i);
-                this->size--;
-                this->HeapifyDown(0, cmp_lgreater);
+            if (cmp_lgreater) {
+                HC::SortHeap(this->arr, this->size, cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                HC::SortHeap(this->arr, this->size, HC::LGreater<T>());
+            } else {
+                throw std::runtime_error("SAC::SortingBinHeap::Sort(): T was not arithmetic and no cmp was provided");
             }
-            this->size = temp_size;
+        }
+
+        template<typename Cmp>
+        void Sort(Cmp cmp_lgreater) {
+            HC::SortHeap(this->arr, this->size, cmp_lgreater);
+        }
+
+        size_t BottomUpSort(bool (*cmp_lgreater)(T, T) = nullptr) {
+            if (cmp_lgreater) {
+                return SortBottomUp(cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return SortBottomUp(HC::LGreater<T>());
+            } else {
+                throw std::runtime_error(
+                    "SAC::SortingBinHeap::BottomUpSort(): T was not arithmetic and no cmp was provided");
+            }
+        }
+
+        template<typename Cmp>
+        size_t BottomUpSort(Cmp cmp_lgreater) {
+            return SortBottomUp(cmp_lgreater);
+        }
+
+        template<size_t ARITY>
+        static void DarySort(T *arr, size_t n, bool (*cmp_lgreater)(T, T) = nullptr) {
+            if (cmp_lgreater) {
+                SortWithDaryHeap<ARITY>(arr, n, cmp_lgreater);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                SortWithDaryHeap<ARITY>(arr, n, HC::LGreater<T>());
+            } else {
+                throw std::runtime_error(
+                    "SAC::SortingBinHeap::DarySort(): T was not arithmetic and no cmp was provided");
+            }
+        }
+
+        template<size_t ARITY, typename Cmp>
+        static void DarySort(T *arr, size_t n, Cmp cmp_lgreater) {
+            SortWithDaryHeap<ARITY>(arr, n, cmp_lgreater);
         }
     };
 
+    template<typename T>
+    class TopK : private BH::BinHeap<T> {
+        template<typename Cmp>
+        struct KeptCmp {
+            Cmp cmp;
+            bool largest;
+
+            bool operator()(const T &data1, const T &data2) const {
+                return largest ? cmp(data2, data1) : cmp(data1, data2);
+            }
+        };
+
+        size_t k;
+        bool largest;
+        bool (*cmp_lgreater)(T, T);
+
+        template<typename Cmp>
+        void OfferWith(const T *chunk, size_t n, KeptCmp<Cmp> cmp_kept) {
+            if (!k) {
+                return;
+            }
+
+            size_t i = 0;
+            for (; i < n && this->size < k; i++) {
+                DA::DynArr<T>::Push(chunk[i]);
+                HC::SiftUp(this->arr, this->size - 1, cmp_kept);
+            }
+
+            for (; i < n; i++) {
+                if (cmp_kept(this->arr[0], chunk[i])) {
+                    this->arr[0] = chunk[i];
+                    HC::SiftDown(this->arr, this->size, 0, cmp_kept);
+                }
+            }
+        }
+
+        template<typename Cmp>
+        void SortedWith(T *out_arr, KeptCmp<Cmp> cmp_kept) const {
+            std::copy_n(this->arr, this->size, out_arr);
+            HC::SortHeap(out_arr, this->size, cmp_kept);
+        }
+
+    public:
+        TopK(size_t in_k, bool in_largest = false, bool (*in_cmp_lgreater)(T, T) = nullptr) : BH::BinHeap<T>(
+            in_k ? in_k : 1) {
+            if constexpr (!std::is_arithmetic_v<T>) {
+                if (!in_cmp_lgreater) {
+                    throw std::runtime_error("SAC::TopK(): T was not arithmetic and no cmp was provided");
+                }
+            }
+
+            k = in_k;
+            largest = in_largest;
+            cmp_lgreater = in_cmp_lgreater;
+        }
+
+        using BH::BinHeap<T>::Size;
+
+        void Offer(const T *chunk, size_t n) {
+            if (cmp_lgreater) {
+                OfferWith(chunk, n, KeptCmp<bool (*)(T, T)>{cmp_lgreater, largest});
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                OfferWith(chunk, n, KeptCmp<HC::LGreater<T> >{HC::LGreater<T>(), largest});
+            }
+        }
+
+        size_t Sorted(T *out_arr) const {
+            if (cmp_lgreater) {
+                SortedWith(out_arr, KeptCmp<bool (*)(T, T)>{cmp_lgreater, largest});
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                SortedWith(out_arr, KeptCmp<HC::LGreater<T> >{HC::LGreater<T>(), largest});
+            }
+
+            return this->size;
+        }
+    };
+
+    template<typename T>
+    size_t PartialSort(const T *arr, size_t n, size_t k, T *out_arr, bool largest = false,
+                       bool (*cmp_lgreater)(T, T) = nullptr) {
+        TopK<T> top_k(k, largest, cmp_lgreater);
+        top_k.Offer(arr, n);
+        return top_k.Sorted(out_arr);
+    }
+
     void CountingSort(int *arr, size_t n, int m) {
         int *cnt_arr = new int[m + 1]();
         int *out_arr = new int[n];
@@ -53,53 +234,865 @@ namespace SAC {
         }
 
         memcpy(arr, out_arr, n * sizeof(int));
+        OC::Add(OC::MOVES, 2 * n);
+
+        delete[] cnt_arr;
+        delete[] out_arr;
+    }
+
+    template<typename T>
+    void RadixSort(T *arr, size_t n);
+
+    template<typename C>
+    void CompactCountingSortCore(int *arr, size_t n, int min, size_t range) {
+        C *cnt_arr = new C[range]();
+
+        for (size_t i = 0; i < n; i++) {
+            cnt_arr[static_cast<int64_t>(arr[i]) - min]++;
+        }
+
+        size_t index = 0;
+        for (size_t v = 0; v < range; v++) {
+            int value = static_cast<int>(min + static_cast<int64_t>(v));
+            for (C c = cnt_arr[v]; c > 0; c--) {
+                arr[index++] = value;
+            }
+        }
+        OC::Add(OC::MOVES, n);
+
+        delete[] cnt_arr;
+    }
+
+    void CompactCountingSort(int *arr, size_t n, int min, int max) {
+        if (n < 2) {
+            return;
+        }
+
+        size_t range = static_cast<size_t>(static_cast<int64_t>(max) - min) + 1;
+        if (range / COUNTING_RANGE_FACTOR > n) {
+            RadixSort(arr, n);
+        } else if (n <= UINT32_MAX) {
+            CompactCountingSortCore<uint32_t>(arr, n, min, range);
+        } else {
+            CompactCountingSortCore<size_t>(arr, n, min, range);
+        }
+    }
+
+    void CompactCountingSort(int *arr, size_t n) {
+        if (n < 2) {
+            return;
+        }
+
+        int min = arr[0];
+        int max = arr[0];
+        for (size_t i = 1; i < n; i++) {
+            if (arr[i] < min) {
+                min = arr[i];
+            } else if (arr[i] > max) {
+                max = arr[i];
+            }
+        }
+
+        CompactCountingSort(arr, n, min, max);
+    }
+
+    template<typename C>
+    void ParallelCountingSortCore(int *arr, size_t n, size_t range, unsigned int threads) {
+        C *cnt_arr = new C[threads * range]();
+        size_t *block_arr = new size_t[threads + 1]();
+        int *out_arr = new int[n];
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            C *cnt = cnt_arr + t * range;
+            for (size_t i = TP::ChunkBegin(n, threads, t); i < TP::ChunkBegin(n, threads, t + 1); i++) {
+                cnt[arr[i]]++;
+            }
+        });
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            C sum = 0;
+            for (size_t v = TP::ChunkBegin(range, threads, t); v < TP::ChunkBegin(range, threads, t + 1); v++) {
+                for (size_t u = 0; u < threads; u++) {
+                    C temp = cnt_arr[u * range + v];
+                    cnt_arr[u * range + v] = sum;
+                    sum += temp;
+                }
+            }
+            block_arr[t + 1] = sum;
+        });
+
+        for (size_t t = 1; t <= threads; t++) {
+            block_arr[t] += block_arr[t - 1];
+        }
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            for (size_t v = TP::ChunkBegin(range, threads, t); v < TP::ChunkBegin(range, threads, t + 1); v++) {
+                for (size_t u = 0; u < threads; u++) {
+                    cnt_arr[u * range + v] += static_cast<C>(block_arr[t]);
+                }
+            }
+        });
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            C *cnt = cnt_arr + t * range;
+            for (size_t i = TP::ChunkBegin(n, threads, t); i < TP::ChunkBegin(n, threads, t + 1); i++) {
+                out_arr[cnt[arr[i]]++] = arr[i];
+            }
+        });
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            size_t begin = TP::ChunkBegin(n, threads, t);
+            memcpy(arr + begin, out_arr + begin, (TP::ChunkBegin(n, threads, t + 1) - begin) * sizeof(int));
+        });
+        OC::Add(OC::MOVES, 2 * n);
 
         delete[] cnt_arr;
+        delete[] block_arr;
+        delete[] out_arr;
+    }
+
+    unsigned int ParallelCountingSort(int *arr, size_t n, int m, unsigned int threads = 0) {
+        if (n < 2) {
+            return 1;
+        }
+
+        size_t range = static_cast<size_t>(m) + 1;
+        threads = TP::Threads(threads);
+        if (threads > n / range) {
+            threads = n / range > 1 ? static_cast<unsigned int>(n / range) : 1;
+        }
+
+        if (threads == 1) {
+            CountingSort(arr, n, m);
+        } else if (n <= UINT32_MAX) {
+            ParallelCountingSortCore<uint32_t>(arr, n, range, threads);
+        } else {
+            ParallelCountingSortCore<size_t>(arr, n, range, threads);
+        }
+
+        return threads;
+    }
+
+    template<typename T>
+    void RadixSort(T *arr, size_t n) {
+        static_assert(std::is_same_v<T, int> || std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>,
+                      "SAC::RadixSort(): T must be int, uint32_t or uint64_t");
+
+        using U = std::make_unsigned_t<T>;
+        constexpr size_t DIGIT_BITS = 8;
+        constexpr size_t RADIX = size_t(1) << DIGIT_BITS;
+        constexpr size_t DIGITS = sizeof(T) * 8 / DIGIT_BITS;
+        constexpr U SIGN_FLIP = std::is_signed_v<T> ? U(1) << (sizeof(T) * 8 - 1) : U(0);
+
+        if (n < 2) {
+            return;
+        }
+
+        size_t *cnt_arr = new size_t[DIGITS * RADIX]();
+        T *out_arr = new T[n];
+
+        for (size_t i = 0; i < n; i++) {
+            U key = static_cast<U>(arr[i]) ^ SIGN_FLIP;
+            for (size_t d = 0; d < DIGITS; d++) {
+                cnt_arr[d * RADIX + ((key >> (d * DIGIT_BITS)) & (RADIX - 1))]++;
+            }
+        }
+
+        T *src = arr;
+        T *dst = out_arr;
+        for (size_t d = 0; d < DIGITS; d++) {
+            size_t *cnt = cnt_arr + d * RADIX;
+            size_t shift = d * DIGIT_BITS;
+
+            if (cnt[((static_cast<U>(src[0]) ^ SIGN_FLIP) >> shift) & (RADIX - 1)] == n) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t b = 0; b < RADIX; b++) {
+                size_t temp = cnt[b];
+                cnt[b] = offset;
+                offset += temp;
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                dst[cnt[((static_cast<U>(src[i]) ^ SIGN_FLIP) >> shift) & (RADIX - 1)]++] = src[i];
+            }
+            OC::Add(OC::MOVES, n);
+
+            T *temp = src;
+            src = dst;
+            dst = temp;
+        }
+
+        if (src != arr) {
+            memcpy(arr, src, n * sizeof(T));
+            OC::Add(OC::MOVES, n);
+        }
+
+        delete[] cnt_arr;
+        delete[] out_arr;
+    }
+
+    template<typename T>
+    void IntroSort(T *arr, size_t n, bool (*cmp_lgreater)(T, T) = nullptr) {
+        if (cmp_lgreater) {
+            IS::Sort(arr, n, cmp_lgreater);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            IS::Sort(arr, n, HC::LGreater<T>());
+        } else {
+            throw std::runtime_error("SAC::IntroSort(): T was not arithmetic and no cmp was provided");
+        }
+    }
+
+    template<typename T, typename Cmp>
+    void IntroSort(T *arr, size_t n, Cmp cmp_lgreater) {
+        IS::Sort(arr, n, cmp_lgreater);
+    }
+
+    template<typename K>
+    using KeyBits = std::conditional_t<sizeof(K) <= sizeof(uint32_t), uint32_t, uint64_t>;
+
+    template<typename K>
+    KeyBits<K> OrderedKey(K key) {
+        using B = KeyBits<K>;
+        constexpr B SIGN = B(1) << (sizeof(B) * 8 - 1);
+
+        if constexpr (std::is_floating_point_v<K>) {
+            static_assert(sizeof(K) == sizeof(B), "SAC::OrderedKey(): unsupported floating point width");
+            if (key == 0) {
+                key = 0;
+            }
+            B bits;
+            memcpy(&bits, &key, sizeof(B));
+            return bits & SIGN ? ~bits : bits | SIGN;
+        } else if constexpr (std::is_signed_v<K>) {
+            using U = std::make_unsigned_t<K>;
+            return static_cast<B>(static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(K) * 8 - 1))));
+        } else {
+            return static_cast<B>(key);
+        }
+    }
+
+    template<typename B, typename I>
+    struct KeyIndex {
+        B key;
+        I index;
+    };
+
+    template<typename B, typename I>
+    void RadixSortPairs(KeyIndex<B, I> *pairs, size_t n) {
+        constexpr size_t DIGIT_BITS = 8;
+        constexpr size_t RADIX = size_t(1) << DIGIT_BITS;
+        constexpr size_t DIGITS = sizeof(B) * 8 / DIGIT_BITS;
+
+        size_t *cnt_arr = new size_t[DIGITS * RADIX]();
+        auto *out_arr = new KeyIndex<B, I>[n];
+
+        for (size_t i = 0; i < n; i++) {
+            for (size_t d = 0; d < DIGITS; d++) {
+                cnt_arr[d * RADIX + ((pairs[i].key >> (d * DIGIT_BITS)) & (RADIX - 1))]++;
+            }
+        }
+
+        KeyIndex<B, I> *src = pairs;
+        KeyIndex<B, I> *dst = out_arr;
+        for (size_t d = 0; d < DIGITS; d++) {
+            size_t *cnt = cnt_arr + d * RADIX;
+            size_t shift = d * DIGIT_BITS;
+
+            if (cnt[(src[0].key >> shift) & (RADIX - 1)] == n) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t b = 0; b < RADIX; b++) {
+                size_t temp = cnt[b];
+                cnt[b] = offset;
+                offset += temp;
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                dst[cnt[(src[i].key >> shift) & (RADIX - 1)]++] = src[i];
+            }
+            OC::Add(OC::MOVES, n);
+
+            KeyIndex<B, I> *temp = src;
+            src = dst;
+            dst = temp;
+        }
+
+        if (src != pairs) {
+            memcpy(pairs, src, n * sizeof(KeyIndex<B, I>));
+            OC::Add(OC::MOVES, n);
+        }
+
+        delete[] cnt_arr;
+        delete[] out_arr;
+    }
+
+    template<typename T, typename K, typename I>
+    void KeySortCore(T *arr, size_t n, K (*fun_sort_key)(T), bool (*cmp_lgreater)(T, T)) {
+        using B = KeyBits<K>;
+
+        auto *pairs = new KeyIndex<B, I>[n];
+        for (size_t i = 0; i < n; i++) {
+            pairs[i] = {OrderedKey(fun_sort_key(arr[i])), static_cast<I>(i)};
+        }
+
+        RadixSortPairs(pairs, n);
+
+        if (cmp_lgreater) {
+            size_t begin = 0;
+            for (size_t i = 1; i <= n; i++) {
+                if (i == n || pairs[i].key != pairs[begin].key) {
+                    if (i - begin > 1) {
+                        IS::Sort(pairs + begin, i - begin, [arr, cmp_lgreater](const KeyIndex<B, I> &pair1,
+                                                                               const KeyIndex<B, I> &pair2) {
+                            return cmp_lgreater(arr[pair1.index], arr[pair2.index]);
+                        });
+                    }
+                    begin = i;
+                }
+            }
+        }
+
+        T *out_arr = new T[n];
+        for (size_t i = 0; i < n; i++) {
+            out_arr[i] = std::move(arr[pairs[i].index]);
+        }
+        std::move(out_arr, out_arr + n, arr);
+        OC::Add(OC::MOVES, 2 * n);
+
+        delete[] pairs;
+        delete[] out_arr;
+    }
+
+    template<typename T, typename K>
+    void KeySort(T *arr, size_t n, K (*fun_sort_key)(T), bool (*cmp_lgreater)(T, T) = nullptr) {
+        static_assert(std::is_arithmetic_v<K>, "SAC::KeySort(): K must be arithmetic");
+
+        if (!fun_sort_key) {
+            throw std::invalid_argument("SAC::KeySort(): fun_sort_key was null");
+        }
+        if (n < 2) {
+            return;
+        }
+
+        if (n <= UINT32_MAX) {
+            KeySortCore<T, K, uint32_t>(arr, n, fun_sort_key, cmp_lgreater);
+        } else {
+            KeySortCore<T, K, size_t>(arr, n, fun_sort_key, cmp_lgreater);
+        }
+    }
+
+    struct PackedKey {
+        uint64_t hi;
+        uint64_t lo;
+    };
+
+    class KeyPacker {
+        PackedKey key;
+        size_t bits;
+
+    public:
+        KeyPacker() : key{0, 0}, bits(0) {
+        }
+
+        template<typename K>
+        KeyPacker &Add(K field) {
+            static_assert(std::is_arithmetic_v<K>, "SAC::KeyPacker::Add(): K must be arithmetic");
+            constexpr size_t FIELD_BITS = sizeof(K) * 8;
+
+            if (bits + FIELD_BITS > 128) {
+                throw std::length_error("SAC::KeyPacker::Add(): packed key exceeded 128 bits");
+            }
+
+            uint64_t data = OrderedKey(field);
+            if constexpr (FIELD_BITS == 64) {
+                key.hi = key.lo;
+                key.lo = data;
+            } else {
+                key.hi = key.hi << FIELD_BITS | key.lo >> (64 - FIELD_BITS);
+                key.lo = key.lo << FIELD_BITS | data;
+            }
+            bits += FIELD_BITS;
+
+            return *this;
+        }
+
+        PackedKey Key() const {
+            return key;
+        }
+    };
+
+    template<typename T>
+    struct PackedRecord {
+        PackedKey key;
+        T payload;
+    };
+
+    template<typename T>
+    void PackedRadixSort(T *arr, size_t n, PackedKey (*fun_packed_key)(T)) {
+        constexpr size_t DIGIT_BITS = 11;
+        constexpr size_t RADIX = size_t(1) << DIGIT_BITS;
+        constexpr size_t DIGITS = (128 + DIGIT_BITS - 1) / DIGIT_BITS;
+
+        if (!fun_packed_key) {
+            throw std::invalid_argument("SAC::PackedRadixSort(): fun_packed_key was null");
+        }
+        if (n < 2) {
+            return;
+        }
+
+        auto *records = new PackedRecord<T>[n];
+        for (size_t i = 0; i < n; i++) {
+            records[i] = {fun_packed_key(arr[i]), arr[i]};
+        }
+
+        if (n <= PACKED_RADIX_THRESHOLD) {
+            IS::Sort(records, n, [](const PackedRecord<T> &record1, const PackedRecord<T> &record2) {
+                OC::Add(OC::COMPARISONS);
+                return record1.key.hi != record2.key.hi
+                           ? record1.key.hi > record2.key.hi
+                           : record1.key.lo > record2.key.lo;
+            });
+            for (size_t i = 0; i < n; i++) {
+                arr[i] = records[i].payload;
+            }
+            OC::Add(OC::MOVES, n);
+
+            delete[] records;
+            return;
+        }
+
+        auto digit = [](const PackedKey &key, size_t d) {
+            unsigned __int128 value = static_cast<unsigned __int128>(key.hi) << 64 | key.lo;
+            return static_cast<size_t>(value >> (d * DIGIT_BITS)) & (RADIX - 1);
+        };
+
+        size_t *cnt_arr = new size_t[DIGITS * RADIX]();
+        auto *out_arr = new PackedRecord<T>[n];
+
+        for (size_t i = 0; i < n; i++) {
+            for (size_t d = 0; d < DIGITS; d++) {
+                cnt_arr[d * RADIX + digit(records[i].key, d)]++;
+            }
+        }
+
+        PackedRecord<T> *src = records;
+        PackedRecord<T> *dst = out_arr;
+        for (size_t d = 0; d < DIGITS; d++) {
+            size_t *cnt = cnt_arr + d * RADIX;
+
+            if (cnt[digit(src[0].key, d)] == n) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t b = 0; b < RADIX; b++) {
+                size_t temp = cnt[b];
+                cnt[b] = offset;
+                offset += temp;
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                dst[cnt[digit(src[i].key, d)]++] = src[i];
+            }
+            OC::Add(OC::MOVES, n);
+
+            PackedRecord<T> *temp = src;
+            src = dst;
+            dst = temp;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            arr[i] = src[i].payload;
+        }
+        OC::Add(OC::MOVES, n);
+
+        delete[] cnt_arr;
+        delete[] records;
         delete[] out_arr;
     }
 
     void BucketSort(int *arr, size_t n, int m) {
-        auto *buckets = new DLL::DoubLinList<int>[n];
+        DLL::NodeArena arena(n * DLL::DoubLinList<int, DLL::ArenaAllocator>::NodeBytes());
+        auto *buckets = new DLL::DoubLinList<int, DLL::ArenaAllocator>[n];
+        for (size_t i = 0; i < n; i++) {
+            buckets[i].SetAllocator(DLL::ArenaAllocator{&arena});
+        }
 
         for (size_t i = 0; i < n; i++) {
             size_t bucket_index = (arr[i] * n) / m;
+            if (bucket_index >= n) {
+                bucket_index = n - 1;
+            }
             buckets[bucket_index].PushBack(arr[i]);
         }
 
         size_t index = 0;
         for (size_t i = 0; i < n; i++) {
-            if (!buckets[i].Empty()) {
-                buckets[i].InsertionSort();
-                for (size_t j = 0; j < buckets[i].Size(); j++) {
-                    arr[index++] = buckets[i][j];
+            if (buckets[i].Empty()) {
+                continue;
+            }
+
+            if (buckets[i].Size() >= SN::MIN_SIZE && buckets[i].Size() <= SN::MAX_SIZE) {
+                size_t begin = index;
+                for (int data: buckets[i]) {
+                    arr[index++] = data;
                 }
+                SN::Sort(arr + begin, index - begin);
+                continue;
+            }
+
+            if (buckets[i].Size() > LIST_MERGE_THRESHOLD) {
+                buckets[i].MergeSort();
+            } else {
+                buckets[i].InsertionSort();
+            }
+            for (int data: buckets[i]) {
+                arr[index++] = data;
             }
         }
+        OC::Add(OC::MOVES, n);
 
         delete[] buckets;
     }
 
     template<typename T>
     void BucketSort(T *arr, size_t n, int m, bool (*cmp_lgreater)(T, T), size_t (*fun_key)(T, size_t)) {
-        auto *buckets = new DLL::DoubLinList<T>[n];
+        DLL::NodeArena arena(n * DLL::DoubLinList<T, DLL::ArenaAllocator>::NodeBytes());
+        auto *buckets = new DLL::DoubLinList<T, DLL::ArenaAllocator>[n];
+        for (size_t i = 0; i < n; i++) {
+            buckets[i].SetAllocator(DLL::ArenaAllocator{&arena});
+        }
 
         for (size_t i = 0; i < n; i++) {
             size_t bucket_index = fun_key(arr[i], n);
+            if (bucket_index >= n) {
+                bucket_index = n - 1;
+            }
             buckets[bucket_index].PushBack(arr[i]);
         }
 
         size_t index = 0;
         for (size_t i = 0; i < n; i++) {
             if (!buckets[i].Empty()) {
-                buckets[i].InsertionSort(cmp_lgreater);
-                for (size_t j = 0; j < buckets[i].Size(); j++) {
-                    arr[index++] = buckets[i][j];
+                if (buckets[i].Size() > LIST_MERGE_THRESHOLD) {
+                    buckets[i].MergeSort(cmp_lgreater);
+                } else {
+                    buckets[i].InsertionSort(cmp_lgreater);
+                }
+                for (const T &data: buckets[i]) {
+                    arr[index++] = data;
                 }
             }
         }
+        OC::Add(OC::MOVES, n);
 
         delete[] buckets;
     }
+
+    template<typename T, typename F>
+    void FlatBucketSortCore(T *arr, size_t n, F fun_bucket, bool (*cmp_lgreater)(T, T)) {
+        if (n < 2) {
+            return;
+        }
+
+        size_t *offset_arr = new size_t[n + 1]();
+        T *out_arr = new T[n];
+
+        for (size_t i = 0; i < n; i++) {
+            offset_arr[fun_bucket(arr[i]) + 1]++;
+        }
+
+        for (size_t i = 1; i <= n; i++) {
+            offset_arr[i] += offset_arr[i - 1];
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            out_arr[offset_arr[fun_bucket(arr[i])]++] = arr[i];
+        }
+
+        size_t begin = 0;
+        for (size_t i = 0; i < n; i++) {
+            size_t end = offset_arr[i];
+            if (end - begin > 1) {
+                IntroSort(out_arr + begin, end - begin, cmp_lgreater);
+            }
+            begin = end;
+        }
+
+        std::move(out_arr, out_arr + n, arr);
+        OC::Add(OC::MOVES, 2 * n);
+
+        delete[] offset_arr;
+        delete[] out_arr;
+    }
+
+    template<typename T, typename Cmp>
+    unsigned int SampleSortCore(T *arr, size_t n, Cmp cmp_lgreater, unsigned int threads);
+
+    template<typename T, typename F>
+    unsigned int ParallelFlatBucketSortCore(T *arr, size_t n, F fun_bucket, bool (*cmp_lgreater)(T, T),
+                                            unsigned int threads) {
+        threads = TP::Threads(threads);
+        if (threads == 1 || n < SAMPLE_SORT_THRESHOLD) {
+            FlatBucketSortCore(arr, n, fun_bucket, cmp_lgreater);
+            return 1;
+        }
+
+        size_t blocks = threads * FLAT_BUCKET_BLOCKS_PER_THREAD;
+        auto block_of = [n, blocks](size_t bucket) { return bucket * blocks / n; };
+        auto first_bucket = [n, blocks](size_t block) { return (block * n + blocks - 1) / blocks; };
+
+        size_t *cnt_arr = new size_t[threads * blocks]();
+        size_t *offset_arr = new size_t[blocks + 1];
+        T *out_arr = new T[n];
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            size_t *cnt = cnt_arr + t * blocks;
+            for (size_t i = TP::ChunkBegin(n, threads, t); i < TP::ChunkBegin(n, threads, t + 1); i++) {
+                cnt[block_of(fun_bucket(arr[i]))]++;
+            }
+        });
+
+        size_t sum = 0;
+        for (size_t b = 0; b < blocks; b++) {
+            offset_arr[b] = sum;
+            for (size_t t = 0; t < threads; t++) {
+                size_t temp = cnt_arr[t * blocks + b];
+                cnt_arr[t * blocks + b] = sum;
+                sum += temp;
+            }
+        }
+        offset_arr[blocks] = n;
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            size_t *cnt = cnt_arr + t * blocks;
+            for (size_t i = TP::ChunkBegin(n, threads, t); i < TP::ChunkBegin(n, threads, t + 1); i++) {
+                out_arr[cnt[block_of(fun_bucket(arr[i]))]++] = std::move(arr[i]);
+            }
+        });
+
+        size_t grain = n / threads;
+        std::mutex large_mtx;
+        std::vector<std::pair<size_t, size_t> > large_buckets;
+        TP::WorkStealingPool pool(threads);
+        for (size_t b = 0; b < blocks; b++) {
+            if (offset_arr[b + 1] == offset_arr[b]) {
+                continue;
+            }
+
+            pool.Submit([&, b]() {
+                size_t begin = offset_arr[b];
+                size_t end = offset_arr[b + 1];
+                size_t bucket_begin = first_bucket(b);
+                size_t buckets = first_bucket(b + 1) - bucket_begin;
+
+                size_t *bucket_arr = new size_t[buckets]();
+                for (size_t i = begin; i < end; i++) {
+                    bucket_arr[fun_bucket(out_arr[i]) - bucket_begin]++;
+                }
+                for (size_t i = 0, bucket_sum = begin; i < buckets; i++) {
+                    size_t temp = bucket_arr[i];
+                    bucket_arr[i] = bucket_sum;
+                    bucket_sum += temp;
+                }
+                for (size_t i = begin; i < end; i++) {
+                    arr[bucket_arr[fun_bucket(out_arr[i]) - bucket_begin]++] = std::move(out_arr[i]);
+                }
+
+                for (size_t i = 0, first = begin; i < buckets; i++) {
+                    size_t last = bucket_arr[i];
+                    if (last - first > grain) {
+                        std::lock_guard<std::mutex> lock(large_mtx);
+                        large_buckets.emplace_back(first, last - first);
+                    } else if (last - first > 1) {
+                        IntroSort(arr + first, last - first, cmp_lgreater);
+                    }
+                    first = last;
+                }
+
+                delete[] bucket_arr;
+            });
+        }
+        pool.Run();
+
+        for (const auto &[first, size]: large_buckets) {
+            if (cmp_lgreater) {
+                SampleSortCore(arr + first, size, cmp_lgreater, threads);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                SampleSortCore(arr + first, size, HC::LGreater<T>(), threads);
+            } else {
+                throw std::runtime_error("SAC::ParallelBucketSort(): T was not arithmetic and no cmp was provided");
+            }
+        }
+        OC::Add(OC::MOVES, 3 * n);
+
+        delete[] cnt_arr;
+        delete[] offset_arr;
+        delete[] out_arr;
+
+        return threads;
+    }
+
+    void FlatBucketSort(int *arr, size_t n, int m) {
+        FlatBucketSortCore<int>(arr, n, [n, m](int data) {
+            size_t bucket_index = (data * n) / m;
+            return bucket_index < n ? bucket_index : n - 1;
+        }, nullptr);
+    }
+
+    template<typename T>
+    void FlatBucketSort(T *arr, size_t n, [[maybe_unused]] int m, bool (*cmp_lgreater)(T, T),
+                        size_t (*fun_key)(T, size_t)) {
+        FlatBucketSortCore<T>(arr, n, [n, fun_key](T data) {
+            size_t bucket_index = fun_key(data, n);
+            return bucket_index < n ? bucket_index : n - 1;
+        }, cmp_lgreater);
+    }
+
+    unsigned int ParallelBucketSort(int *arr, size_t n, int m, unsigned int threads = 0) {
+        return ParallelFlatBucketSortCore<int>(arr, n, [n, m](int data) {
+            size_t bucket_index = (data * n) / m;
+            return bucket_index < n ? bucket_index : n - 1;
+        }, nullptr, threads);
+    }
+
+    template<typename T>
+    unsigned int ParallelBucketSort(T *arr, size_t n, [[maybe_unused]] int m, bool (*cmp_lgreater)(T, T),
+                                    size_t (*fun_key)(T, size_t), unsigned int threads = 0) {
+        return ParallelFlatBucketSortCore<T>(arr, n, [n, fun_key](T data) {
+            size_t bucket_index = fun_key(data, n);
+            return bucket_index < n ? bucket_index : n - 1;
+        }, cmp_lgreater, threads);
+    }
+
+    template<typename T, typename Cmp>
+    unsigned int SampleSortCore(T *arr, size_t n, Cmp cmp_lgreater, unsigned int threads) {
+        threads = TP::Threads(threads);
+        if (n < SAMPLE_SORT_THRESHOLD || threads == 1) {
+            IS::Sort(arr, n, cmp_lgreater);
+            return 1;
+        }
+
+        size_t log_buckets = 1;
+        while ((size_t(1) << log_buckets) < 8 * threads && (size_t(1) << log_buckets) < MAX_SAMPLE_BUCKETS) {
+            log_buckets++;
+        }
+        size_t buckets = size_t(1) << log_buckets;
+
+        size_t sample_size = buckets * SAMPLE_OVERSAMPLING;
+        T *sample_arr = new T[sample_size];
+        uint64_t state = n;
+        for (size_t i = 0; i < sample_size; i++) {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t x = state;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            sample_arr[i] = arr[static_cast<size_t>((static_cast<unsigned __int128>(x ^ (x >> 31)) * n) >> 64)];
+        }
+        IS::Sort(sample_arr, sample_size, cmp_lgreater);
+
+        T *splitter_arr = new T[buckets - 1];
+        bool equal_buckets = false;
+        for (size_t b = 0; b < buckets - 1; b++) {
+            splitter_arr[b] = sample_arr[(b + 1) * SAMPLE_OVERSAMPLING - 1];
+            equal_buckets = equal_buckets || (b && !cmp_lgreater(splitter_arr[b], splitter_arr[b - 1]));
+        }
+        delete[] sample_arr;
+
+        T *tree_arr = new T[buckets];
+        for (size_t node = 1, level = 0; level < log_buckets; level++) {
+            for (size_t i = 0; i < (size_t(1) << level); i++, node++) {
+                tree_arr[node] = splitter_arr[((2 * i + 1) << (log_buckets - level - 1)) - 1];
+            }
+        }
+
+        size_t all_buckets = equal_buckets ? 2 * buckets : buckets;
+        auto *oracle_arr = new uint16_t[n];
+        size_t *cnt_arr = new size_t[threads * all_buckets]();
+        size_t *offset_arr = new size_t[all_buckets + 1];
+        T *out_arr = new T[n];
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            size_t *cnt = cnt_arr + t * all_buckets;
+            for (size_t i = TP::ChunkBegin(n, threads, t); i < TP::ChunkBegin(n, threads, t + 1); i++) {
+                size_t node = 1;
+                for (size_t level = 0; level < log_buckets; level++) {
+                    node = 2 * node + static_cast<size_t>(cmp_lgreater(arr[i], tree_arr[node]));
+                }
+                size_t b = node - buckets;
+                if (equal_buckets) {
+                    b = 2 * b + static_cast<size_t>(b < buckets - 1 && !cmp_lgreater(splitter_arr[b], arr[i]));
+                }
+                oracle_arr[i] = static_cast<uint16_t>(b);
+                cnt[b]++;
+            }
+        });
+
+        size_t sum = 0;
+        for (size_t b = 0; b < all_buckets; b++) {
+            offset_arr[b] = sum;
+            for (size_t t = 0; t < threads; t++) {
+                size_t temp = cnt_arr[t * all_buckets + b];
+                cnt_arr[t * all_buckets + b] = sum;
+                sum += temp;
+            }
+        }
+        offset_arr[all_buckets] = n;
+
+        TP::ParallelFor(threads, [&](unsigned int t) {
+            size_t *cnt = cnt_arr + t * all_buckets;
+            for (size_t i = TP::ChunkBegin(n, threads, t); i < TP::ChunkBegin(n, threads, t + 1); i++) {
+                out_arr[cnt[oracle_arr[i]]++] = std::move(arr[i]);
+            }
+        });
+
+        TP::WorkStealingPool pool(threads);
+        for (size_t b = 0; b < all_buckets; b++) {
+            if (offset_arr[b + 1] == offset_arr[b]) {
+                continue;
+            }
+
+            pool.Submit([&, b]() {
+                size_t begin = offset_arr[b];
+                size_t end = offset_arr[b + 1];
+                if (!equal_buckets || !(b & 1)) {
+                    IS::Sort(out_arr + begin, end - begin, cmp_lgreater);
+                }
+                std::move(out_arr + begin, out_arr + end, arr + begin);
+            });
+        }
+        pool.Run();
+        OC::Add(OC::MOVES, 2 * n);
+
+        delete[] splitter_arr;
+        delete[] tree_arr;
+        delete[] oracle_arr;
+        delete[] cnt_arr;
+        delete[] offset_arr;
+        delete[] out_arr;
+
+        return threads;
+    }
+
+    unsigned int ParallelSampleSort(int *arr, size_t n, unsigned int threads = 0) {
+        return SampleSortCore(arr, n, HC::LGreater<int>(), threads);
+    }
+
+    template<typename T>
+    unsigned int ParallelSampleSort(T *arr, size_t n, bool (*cmp_lgreater)(T, T), unsigned int threads = 0) {
+        if (cmp_lgreater) {
+            return SampleSortCore(arr, n, cmp_lgreater, threads);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return SampleSortCore(arr, n, HC::LGreater<T>(), threads);
+        } else {
+            throw std::runtime_error("SAC::ParallelSampleSort(): T was not arithmetic and no cmp was provided");
+        }
+    }
 }
 
 #endif
@@ -0,0 +1,226 @@
+#ifndef SN_H
+#define SN_H
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "OC.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SN_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace SN {
+    constexpr size_t MIN_SIZE = 4;
+    constexpr size_t MAX_SIZE = 64;
+    constexpr size_t LANES = 8;
+
+    template<typename T>
+    constexpr bool SORTABLE = std::is_same_v<T, int> || std::is_same_v<T, float>;
+
+    template<typename T>
+    constexpr T Sentinel() {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::max();
+    }
+
+    template<size_t N>
+    constexpr size_t Comparators() {
+        size_t log_n = 0;
+        while ((size_t(1) << log_n) < N) {
+            log_n++;
+        }
+        return N / 2 * log_n * (log_n + 1) / 2;
+    }
+
+    inline bool Avx2() {
+#ifdef SN_AVX2
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    template<typename T, size_t N>
+    void ScalarNetwork(T *arr) {
+        for (size_t k = 2; k <= N; k *= 2) {
+            for (size_t j = k / 2; j > 0; j /= 2) {
+                for (size_t i = 0; i < N; i++) {
+                    size_t l = i ^ j;
+                    if (l > i) {
+                        bool ascending = !(i & k);
+                        if (ascending ? arr[l] < arr[i] : arr[i] < arr[l]) {
+                            std::swap(arr[i], arr[l]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef SN_AVX2
+    template<typename T>
+    struct Avx2Ops;
+
+    template<>
+    struct Avx2Ops<int> {
+        using V = __m256i;
+
+        __attribute__((target("avx2"))) static V Load(const int *arr, __m256i mask) {
+            return _mm256_blendv_epi8(_mm256_set1_epi32(Sentinel<int>()), _mm256_maskload_epi32(arr, mask), mask);
+        }
+
+        __attribute__((target("avx2"))) static void Store(int *arr, __m256i mask, V v) {
+            _mm256_maskstore_epi32(arr, mask, v);
+        }
+
+        __attribute__((target("avx2"))) static void Exchange(V &low, V &high) {
+            V temp = _mm256_min_epi32(low, high);
+            high = _mm256_max_epi32(low, high);
+            low = temp;
+        }
+
+        __attribute__((target("avx2"))) static V Exchange(V v, V other, __m256i take_low) {
+            return _mm256_blendv_epi8(_mm256_max_epi32(v, other), _mm256_min_epi32(v, other), take_low);
+        }
+
+        __attribute__((target("avx2"))) static V Permute(V v, __m256i index) {
+            return _mm256_permutevar8x32_epi32(v, index);
+        }
+    };
+
+    template<>
+    struct Avx2Ops<float> {
+        using V = __m256;
+
+        __attribute__((target("avx2"))) static V Load(const float *arr, __m256i mask) {
+            return _mm256_blendv_ps(_mm256_set1_ps(Sentinel<float>()), _mm256_maskload_ps(arr, mask),
+                                    _mm256_castsi256_ps(mask));
+        }
+
+        __attribute__((target("avx2"))) static void Store(float *arr, __m256i mask, V v) {
+            _mm256_maskstore_ps(arr, mask, v);
+        }
+
+        __attribute__((target("avx2"))) static void Exchange(V &low, V &high) {
+            V swap = _mm256_cmp_ps(high, low, _CMP_LT_OQ);
+            V temp = _mm256_blendv_ps(low, high, swap);
+            high = _mm256_blendv_ps(high, low, swap);
+            low = temp;
+        }
+
+        __attribute__((target("avx2"))) static V Exchange(V v, V other, __m256i take_low) {
+            V swap = _mm256_blendv_ps(_mm256_cmp_ps(v, other, _CMP_LT_OQ), _mm256_cmp_ps(other, v, _CMP_LT_OQ),
+                                      _mm256_castsi256_ps(take_low));
+            return _mm256_blendv_ps(v, other, swap);
+        }
+
+        __attribute__((target("avx2"))) static V Permute(V v, __m256i index) {
+            return _mm256_permutevar8x32_ps(v, index);
+        }
+    };
+
+    template<typename T, size_t N>
+    __attribute__((target("avx2"))) void Avx2Network(T *arr, size_t n) {
+        using Ops = Avx2Ops<T>;
+        constexpr size_t VECTORS = N / LANES;
+
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i masks[VECTORS];
+        typename Ops::V v[VECTORS];
+        for (size_t x = 0; x < VECTORS; x++) {
+            masks[x] = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n - x * LANES)), lane);
+            v[x] = Ops::Load(arr + x * LANES, masks[x]);
+        }
+
+#pragma GCC unroll 8
+        for (size_t k = 2; k <= N; k *= 2) {
+#pragma GCC unroll 8
+            for (size_t j = k / 2; j > 0; j /= 2) {
+                if (j >= LANES) {
+                    size_t stride = j / LANES;
+#pragma GCC unroll 8
+                    for (size_t x = 0; x < VECTORS; x++) {
+                        if (x & stride) {
+                            continue;
+                        }
+
+                        if (x * LANES & k) {
+                            Ops::Exchange(v[x + stride], v[x]);
+                        } else {
+                            Ops::Exchange(v[x], v[x + stride]);
+                        }
+                    }
+                    continue;
+                }
+
+                __m256i partner = _mm256_xor_si256(lane, _mm256_set1_epi32(static_cast<int>(j)));
+#pragma GCC unroll 8
+                for (size_t x = 0; x < VECTORS; x++) {
+                    __m256i index = _mm256_add_epi32(lane, _mm256_set1_epi32(static_cast<int>(x * LANES)));
+                    __m256i lower = _mm256_cmpeq_epi32(_mm256_and_si256(index, _mm256_set1_epi32(static_cast<int>(j))),
+                                                       zero);
+                    __m256i ascending = _mm256_cmpeq_epi32(
+                        _mm256_and_si256(index, _mm256_set1_epi32(static_cast<int>(k))), zero);
+                    __m256i take_low = _mm256_cmpeq_epi32(lower, ascending);
+
+                    typename Ops::V other = Ops::Permute(v[x], partner);
+                    v[x] = Ops::Exchange(v[x], other, take_low);
+                }
+            }
+        }
+
+        for (size_t x = 0; x < VECTORS; x++) {
+            Ops::Store(arr + x * LANES, masks[x], v[x]);
+        }
+    }
+#endif
+
+    template<typename T, size_t N>
+    void Network(T *arr, size_t n) {
+#ifdef SN_AVX2
+        if (Avx2()) {
+            Avx2Network<T, N>(arr, n);
+            OC::Add(OC::COMPARISONS, Comparators<N>());
+            return;
+        }
+#endif
+        T buffer[N];
+        std::copy_n(arr, n, buffer);
+        std::fill(buffer + n, buffer + N, Sentinel<T>());
+        ScalarNetwork<T, N>(buffer);
+        std::copy_n(buffer, n, arr);
+        OC::Add(OC::COMPARISONS, Comparators<N>());
+    }
+
+    template<typename T>
+    void Sort(T *arr, size_t n) {
+        static_assert(SORTABLE<T>, "SN::Sort: T must be int or float");
+
+        if (n < 2) {
+            return;
+        }
+
+        if (n <= 8) {
+            Network<T, 8>(arr, n);
+        } else if (n <= 16) {
+            Network<T, 16>(arr, n);
+        } else if (n <= 32) {
+            Network<T, 32>(arr, n);
+        } else if (n <= MAX_SIZE) {
+            Network<T, 64>(arr, n);
+        } else {
+            throw std::length_error("SN::Sort(): n (" + std::to_string(n) + ") was greater than " +
+                                    std::to_string(MAX_SIZE));
+        }
+        OC::Add(OC::MOVES, 2 * n);
+    }
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef TP_H
+#define TP_H
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TP {
+    inline unsigned int Threads(unsigned int threads = 0) {
+        if (!threads) {
+            threads = std::thread::hardware_concurrency();
+        }
+
+        return threads ? threads : 1;
+    }
+
+    inline size_t ChunkBegin(size_t n, unsigned int threads, unsigned int tid) {
+        return n / threads * tid + (tid < n % threads ? tid : n % threads);
+    }
+
+    template<typename F>
+    void ParallelFor(unsigned int threads, F &&fun) {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+
+        for (unsigned int t = 1; t < threads; t++) {
+            workers.emplace_back([&fun, t]() { fun(t); });
+        }
+        fun(0u);
+
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+    }
+
+    class WorkStealingPool {
+        struct TaskQueue {
+            std::mutex mtx;
+            std::deque<std::function<void()> > tasks;
+        };
+
+        unsigned int threads;
+        TaskQueue *queues;
+        size_t next_queue;
+
+        bool Take(unsigned int tid, std::function<void()> &task) {
+            {
+                std::lock_guard<std::mutex> lock(queues[tid].mtx);
+                if (!queues[tid].tasks.empty()) {
+                    task = std::move(queues[tid].tasks.back());
+                    queues[tid].tasks.pop_back();
+                    return true;
+                }
+            }
+
+            for (unsigned int i = 1; i < threads; i++) {
+                TaskQueue &victim = queues[(tid + i) % threads];
+                std::lock_guard<std::mutex> lock(victim.mtx);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    public:
+        WorkStealingPool(unsigned int in_threads = 0) {
+            threads = TP::Threads(in_threads);
+            queues = new TaskQueue[threads];
+            next_queue = 0;
+        }
+
+        WorkStealingPool(const WorkStealingPool &) = delete;
+
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        ~WorkStealingPool() {
+            delete[] queues;
+        }
+
+        unsigned int Threads() const {
+            return threads;
+        }
+
+        void Submit(std::function<void()> task) {
+            TaskQueue &queue = queues[next_queue++ % threads];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        void Run() {
+            ParallelFor(threads, [this](unsigned int tid) {
+                std::function<void()> task;
+                while (Take(tid, task)) {
+                    task();
+                }
+            });
+            next_queue = 0;
+        }
+    };
+}
+
+#endif
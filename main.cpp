@@ -1,8 +1,105 @@
 #include <iostream>
-#include <random>
+#include <fstream>
+#include <functional>
 #include <chrono>
+#include <vector>
+#include <unistd.h>
+#include "BM.h"
+#include "ES.h"
+#include "GEN.h"
+#include "LT.h"
+#include "MEM.h"
+#include "PC.h"
 #include "SAC.h"
 
+void *operator new(size_t bytes) {
+    void *mem = MEM::Allocate(bytes, MEM::HEADER_SIZE);
+    if (!mem) {
+        throw std::bad_alloc();
+    }
+    return mem;
+}
+
+void *operator new[](size_t bytes) {
+    return operator new(bytes);
+}
+
+void *operator new(size_t bytes, std::align_val_t align) {
+    void *mem = MEM::Allocate(bytes, static_cast<size_t>(align));
+    if (!mem) {
+        throw std::bad_alloc();
+    }
+    return mem;
+}
+
+void *operator new[](size_t bytes, std::align_val_t align) {
+    return operator new(bytes, align);
+}
+
+void *operator new(size_t bytes, const std::nothrow_t &) noexcept {
+    return MEM::Allocate(bytes, MEM::HEADER_SIZE);
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t &) noexcept {
+    return MEM::Allocate(bytes, MEM::HEADER_SIZE);
+}
+
+void *operator new(size_t bytes, std::align_val_t align, const std::nothrow_t &) noexcept {
+    return MEM::Allocate(bytes, static_cast<size_t>(align));
+}
+
+void *operator new[](size_t bytes, std::align_val_t align, const std::nothrow_t &) noexcept {
+    return MEM::Allocate(bytes, static_cast<size_t>(align));
+}
+
+void operator delete(void *mem) noexcept {
+    MEM::Deallocate(mem, MEM::HEADER_SIZE);
+}
+
+void operator delete[](void *mem) noexcept {
+    MEM::Deallocate(mem, MEM::HEADER_SIZE);
+}
+
+void operator delete(void *mem, size_t) noexcept {
+    MEM::Deallocate(mem, MEM::HEADER_SIZE);
+}
+
+void operator delete[](void *mem, size_t) noexcept {
+    MEM::Deallocate(mem, MEM::HEADER_SIZE);
+}
+
+void operator delete(void *mem, std::align_val_t align) noexcept {
+    MEM::Deallocate(mem, static_cast<size_t>(align));
+}
+
+void operator delete[](void *mem, std::align_val_t align) noexcept {
+    MEM::Deallocate(mem, static_cast<size_t>(align));
+}
+
+void operator delete(void *mem, size_t, std::align_val_t align) noexcept {
+    MEM::Deallocate(mem, static_cast<size_t>(align));
+}
+
+void operator delete[](void *mem, size_t, std::align_val_t align) noexcept {
+    MEM::Deallocate(mem, static_cast<size_t>(align));
+}
+
+void operator delete(void *mem, const std::nothrow_t &) noexcept {
+    MEM::Deallocate(mem, MEM::HEADER_SIZE);
+}
+
+void operator delete[](void *mem, const std::nothrow_t &) noexcept {
+    MEM::Deallocate(mem, MEM::HEADER_SIZE);
+}
+
+void operator delete(void *mem, std::align_val_t align, const std::nothrow_t &) noexcept {
+    MEM::Deallocate(mem, static_cast<size_t>(align));
+}
+
+void operator delete[](void *mem, std::align_val_t align, const std::nothrow_t &) noexcept {
+    MEM::Deallocate(mem, static_cast<size_t>(align));
+}
+
 struct some_object {
     double field_1;
     char field_2;
@@ -13,6 +110,7 @@ std::string so_fun_str(some_object *so) {
 }
 
 bool so_cmp_lgreater(some_object *so1, some_object *so2) {
+    OC::Add(OC::COMPARISONS);
     if (so1->field_1 == so2->field_1) {
         return so1->field_2 > so2->field_2;
     }
@@ -30,6 +128,14 @@ size_t so_fun_key(some_object *so, size_t n) {
     return static_cast<size_t>(so->field_1 * n);
 }
 
+double so_fun_sort_key(some_object *so) {
+    return so->field_1;
+}
+
+SAC::PackedKey so_fun_packed_key(some_object *so) {
+    return SAC::KeyPacker().Add(so->field_1).Add(so->field_2).Key();
+}
+
 template<typename T>
 std::string PrintArray(T *array, size_t n, size_t limit = 0, std::string (*cmp_string)(T) = nullptr) {
     if (limit == 0 || limit > n) {
@@ -83,149 +189,642 @@ bool CompareArrays(T *array1, T *array2, T *array3, size_t n, bool (*cmp_equal)(
     return true;
 }
 
-void TestForInts(const int MAX_ORDER, const int m, std::default_random_engine &dre) {
-    std::uniform_int_distribution<int> rnd_num(0, m);
+template<typename T>
+struct Algorithm {
+    std::string name;
+    unsigned int threads;
+    std::function<void(T *, size_t, BM::Metrics &)> sort;
+    size_t checked = 0;
+};
+
+std::vector<unsigned int> ThreadCounts(const BM::Options &options) {
+    if (!options.threads.empty()) {
+        return options.threads;
+    }
+
+    std::vector<unsigned int> threads;
+    for (unsigned int t = 1; t < TP::Threads(); t *= 2) {
+        threads.push_back(t);
+    }
+    threads.push_back(TP::Threads());
+
+    return threads;
+}
+
+std::vector<Algorithm<int> > IntAlgorithms(const BM::Options &options) {
+    const int m = options.m;
+    const size_t k = options.k;
+
+    std::vector<Algorithm<int> > algorithms = {
+        {"counting", 0, [m](int *arr, size_t n, BM::Metrics &) { SAC::CountingSort(arr, n, m); }},
+        {"compact-counting", 0, [](int *arr, size_t n, BM::Metrics &) { SAC::CompactCountingSort(arr, n); }},
+        {
+            "heap", 0, [](int *arr, size_t n, BM::Metrics &) {
+                SAC::SortingBinHeap<int> sbh(arr, n, true);
+                sbh.Sort();
+            }
+        },
+        {"dary-heap-2", 0, [](int *arr, size_t n, BM::Metrics &) { SAC::SortingBinHeap<int>::DarySort<2>(arr, n); }},
+        {"dary-heap-4", 0, [](int *arr, size_t n, BM::Metrics &) { SAC::SortingBinHeap<int>::DarySort<4>(arr, n); }},
+        {"dary-heap-8", 0, [](int *arr, size_t n, BM::Metrics &) { SAC::SortingBinHeap<int>::DarySort<8>(arr, n); }},
+        {
+            "top-k", 0, [k](int *arr, size_t n, BM::Metrics &) {
+                constexpr size_t CHUNK_SIZE = 1 << 12;
+                SAC::TopK<int> top_k(k);
+                for (size_t begin = 0; begin < n; begin += CHUNK_SIZE) {
+                    top_k.Offer(arr + begin, std::min(CHUNK_SIZE, n - begin));
+                }
+                top_k.Sorted(arr);
+            },
+            k
+        },
+        {"bucket", 0, [m](int *arr, size_t n, BM::Metrics &) { SAC::BucketSort(arr, n, m); }},
+        {"flat-bucket", 0, [m](int *arr, size_t n, BM::Metrics &) { SAC::FlatBucketSort(arr, n, m); }},
+        {"radix", 0, [](int *arr, size_t n, BM::Metrics &) { SAC::RadixSort(arr, n); }},
+        {"intro", 0, [](int *arr, size_t n, BM::Metrics &) { SAC::IntroSort(arr, n); }},
+    };
+
+    for (unsigned int threads: ThreadCounts(options)) {
+        algorithms.push_back({
+            "parallel-counting", threads, [m, threads](int *arr, size_t n, BM::Metrics &metrics) {
+                metrics.Set("threads-used", SAC::ParallelCountingSort(arr, n, m, threads));
+            }
+        });
+    }
+    for (unsigned int threads: ThreadCounts(options)) {
+        algorithms.push_back({
+            "parallel-bucket", threads, [m, threads](int *arr, size_t n, BM::Metrics &metrics) {
+                metrics.Set("threads-used", SAC::ParallelBucketSort(arr, n, m, threads));
+            }
+        });
+    }
+    for (unsigned int threads: ThreadCounts(options)) {
+        algorithms.push_back({
+            "parallel-sample", threads, [threads](int *arr, size_t n, BM::Metrics &metrics) {
+                metrics.Set("threads-used", SAC::ParallelSampleSort(arr, n, threads));
+            }
+        });
+    }
+
+    return algorithms;
+}
+
+std::vector<Algorithm<some_object *> > ObjectAlgorithms(const BM::Options &options) {
+    const int m = options.m;
+
+    std::vector<Algorithm<some_object *> > algorithms = {
+        {
+            "heap", 0, [](some_object **arr, size_t n, BM::Metrics &metrics) {
+                SAC::SortingBinHeap<some_object *> sbh(arr, n, true, so_cmp_lgreater);
+                size_t comparisons = 0;
+                sbh.Sort(HC::CountingCmp<bool (*)(some_object *, some_object *)>{so_cmp_lgreater, &comparisons});
+                metrics.Set("comparisons", static_cast<double>(comparisons));
+            }
+        },
+        {
+            "bottom-up-heap", 0, [](some_object **arr, size_t n, BM::Metrics &metrics) {
+                SAC::SortingBinHeap<some_object *> sbh(arr, n, true, so_cmp_lgreater);
+                metrics.Set("comparisons", static_cast<double>(sbh.BottomUpSort(so_cmp_lgreater)));
+            }
+        },
+        {
+            "bucket", 0, [m](some_object **arr, size_t n, BM::Metrics &) {
+                SAC::BucketSort(arr, n, m, so_cmp_lgreater, so_fun_key);
+            }
+        },
+        {
+            "flat-bucket", 0, [m](some_object **arr, size_t n, BM::Metrics &) {
+                SAC::FlatBucketSort(arr, n, m, so_cmp_lgreater, so_fun_key);
+            }
+        },
+        {"intro", 0, [](some_object **arr, size_t n, BM::Metrics &) { SAC::IntroSort(arr, n, so_cmp_lgreater); }},
+        {
+            "key-index", 0, [](some_object **arr, size_t n, BM::Metrics &) {
+                SAC::KeySort(arr, n, so_fun_sort_key, so_cmp_lgreater);
+            }
+        },
+        {
+            "packed-radix", 0, [](some_object **arr, size_t n, BM::Metrics &) {
+                SAC::PackedRadixSort(arr, n, so_fun_packed_key);
+            }
+        },
+    };
+
+    for (unsigned int threads: ThreadCounts(options)) {
+        algorithms.push_back({
+            "parallel-bucket", threads, [m, threads](some_object **arr, size_t n, BM::Metrics &metrics) {
+                metrics.Set("threads-used", SAC::ParallelBucketSort(arr, n, m, so_cmp_lgreater, so_fun_key, threads));
+            }
+        });
+    }
+    for (unsigned int threads: ThreadCounts(options)) {
+        algorithms.push_back({
+            "parallel-sample", threads, [threads](some_object **arr, size_t n, BM::Metrics &metrics) {
+                metrics.Set("threads-used", SAC::ParallelSampleSort(arr, n, so_cmp_lgreater, threads));
+            }
+        });
+    }
+
+    return algorithms;
+}
+
+struct MergeHead {
+    int value;
+    size_t run;
+};
+
+bool mh_cmp_lgreater(MergeHead mh1, MergeHead mh2) {
+    return mh1.value < mh2.value || (mh1.value == mh2.value && mh1.run < mh2.run);
+}
+
+void HeapMerge(const int *const *runs, const size_t *sizes, size_t k, int *out_arr) {
+    BH::BinHeap<MergeHead> heap(k);
+    size_t *next = new size_t[k]();
+    for (size_t i = 0; i < k; i++) {
+        if (sizes[i]) {
+            heap.Push({runs[i][next[i]++], i}, mh_cmp_lgreater);
+        }
+    }
+
+    size_t out = 0;
+    while (heap.Size()) {
+        MergeHead head = heap.Poll(mh_cmp_lgreater);
+        out_arr[out++] = head.value;
+        if (next[head.run] < sizes[head.run]) {
+            heap.Push({runs[head.run][next[head.run]++], head.run}, mh_cmp_lgreater);
+        }
+    }
+
+    delete[] next;
+}
 
-    for (int i = 1; i <= MAX_ORDER; i++) {
-        std::cout << "==========================================================" << std::endl;
-        std::cout << "Test: " << i << std::endl << std::endl;
+std::vector<Algorithm<int> > MergeAlgorithms(size_t k) {
+    auto merge = [k](void (*fun_merge)(const int *const *, const size_t *, size_t, int *)) {
+        return [k, fun_merge](int *arr, size_t n, BM::Metrics &metrics) {
+            const int **runs = new const int *[k];
+            size_t *sizes = new size_t[k];
+            for (size_t i = 0; i < k; i++) {
+                runs[i] = arr + TP::ChunkBegin(n, k, i);
+                sizes[i] = TP::ChunkBegin(n, k, i + 1) - TP::ChunkBegin(n, k, i);
+            }
 
-        int n = static_cast<int>(pow(10, i));
+            int *out_arr = new int[n];
+            fun_merge(runs, sizes, k, out_arr);
+            memcpy(arr, out_arr, n * sizeof(int));
+            metrics.Set("k", static_cast<double>(k));
 
-        int *array1 = new int[n];
-        int *array2 = new int[n];
-        int *array3 = new int[n];
+            delete[] out_arr;
+            delete[] runs;
+            delete[] sizes;
+        };
+    };
 
-        for (int j = 0; j < n; j++) {
-            array1[j] = rnd_num(dre);
+    return {
+        {
+            "loser-tree-merge", 0, merge([](const int *const *runs, const size_t *sizes, size_t k, int *out_arr) {
+                LT::Merge(runs, sizes, k, out_arr);
+            })
+        },
+        {"heap-merge", 0, merge(HeapMerge)},
+    };
+}
+
+template<typename T>
+BM::Result RunAlgorithm(const BM::Options &options, const std::string &suite, const std::string &distribution,
+                        const Algorithm<T> &algorithm, T *input, T *reference, size_t n,
+                        bool (*cmp_equal)(T, T) = nullptr, std::string (*cmp_string)(T) = nullptr) {
+    BM::Result result;
+    result.suite = suite;
+    result.distribution = distribution;
+    result.algorithm = algorithm.name;
+    result.threads = algorithm.threads;
+    result.n = n;
+    result.m = options.m;
+    result.seed = options.seed;
+
+    PC::Counters counters;
+    T *work = new T[n];
+    for (size_t trial = 0; trial < options.warmup + options.trials; trial++) {
+        memcpy(work, input, n * sizeof(T));
+
+        BM::Metrics metrics;
+        OC::Reset();
+        counters.Start();
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        algorithm.sort(work, n, metrics);
+        std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+        counters.Stop(trial >= options.warmup);
+
+        if (trial >= options.warmup) {
+            result.times.push_back(std::chrono::duration<double>(end_time - start_time).count());
+            result.metrics = metrics;
+
+            if constexpr (OC::ENABLED) {
+                double n_log_n = n > 1 ? n * std::log2(static_cast<double>(n)) : 1;
+                result.metrics.Set("comparisons/nlogn", OC::Get(OC::COMPARISONS) / n_log_n);
+                result.metrics.Set("moves/nlogn", OC::Get(OC::MOVES) / n_log_n);
+                result.metrics.Set("allocations/nlogn", OC::Get(OC::ALLOCATIONS) / n_log_n);
+            }
         }
-        memcpy(array2, array1, n * sizeof(int));
-        memcpy(array3, array1, n * sizeof(int));
+    }
 
-        std::cout << "Initial " << PrintArray(array1, n, 8) << std::endl;
+    memcpy(work, input, n * sizeof(T));
+    BM::Metrics memory_metrics;
+    MEM::RssSampler sampler;
+    sampler.Start();
+    MEM::Reset();
+    algorithm.sort(work, n, memory_metrics);
+    MEM::Stats memory = MEM::Read();
+    size_t rss = sampler.Stop();
+
+    result.metrics.Set("alloc-bytes", static_cast<double>(memory.allocated_bytes));
+    result.metrics.Set("peak-bytes", static_cast<double>(memory.peak_bytes));
+    result.metrics.Set("allocations", static_cast<double>(memory.allocations));
+    result.metrics.Set("peak-rss-bytes", static_cast<double>(rss));
+
+    double cycles = 0;
+    double instructions = 0;
+    for (const auto &[name, value]: counters.Averages()) {
+        result.metrics.Set(name, value);
+        if (name == "cycles") {
+            cycles = value;
+        } else if (name == "instructions") {
+            instructions = value;
+        }
+    }
+    if (cycles > 0 && instructions > 0) {
+        result.metrics.Set("ipc", instructions / cycles);
+    }
 
+    size_t checked = algorithm.checked && algorithm.checked < n ? algorithm.checked : n;
+    result.correct = CompareArrays(reference, work, work, checked, cmp_equal);
+    if (options.preview && (options.format == "text" || !options.output.empty())) {
+        std::cout << algorithm.name << " " << PrintArray(work, n, options.preview, cmp_string) << std::endl;
+    }
 
-        std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
-        SAC::CountingSort(array1, n, m);
-        std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+    delete[] work;
+    return result;
+}
 
-        std::chrono::duration<double> counting_sort_time = end_time - start_time;
-        std::cout << "Counting " << PrintArray(array1, n, 8) << std::endl;
+void PrintSummary(const std::vector<BM::Result> &results, size_t first, const std::string &distribution, size_t n,
+                  int m) {
+    constexpr size_t LABEL_WIDTH = 40;
+    bool all_correct = true;
+
+    std::cout << "-----------SUMMARY-----------" << std::endl;
+    std::cout << std::string("distribution").append(LABEL_WIDTH - 12, ' ') << "| " << distribution << std::endl;
+    std::cout << std::string("n").append(LABEL_WIDTH - 1, ' ') << "| " << n << std::endl;
+    std::cout << std::string("m").append(LABEL_WIDTH - 1, ' ') << "| " << m << std::endl;
+    std::cout << std::string(LABEL_WIDTH, ' ') << "| median / min / p95 / p99" << std::endl;
+
+    for (size_t i = first; i < results.size(); i++) {
+        const BM::Result &result = results[i];
+        BM::Stats stats = BM::Summarize(result.times);
+
+        auto threads_used = static_cast<unsigned int>(result.metrics.Get("threads-used", result.threads));
+        std::string label = result.algorithm;
+        if (result.threads && threads_used != result.threads) {
+            label += " (" + std::to_string(threads_used) + " of " + std::to_string(result.threads) + " threads)";
+        } else if (result.threads) {
+            label += " (" + std::to_string(result.threads) + " threads)";
+        }
+        label.resize(LABEL_WIDTH, ' ');
 
+        std::cout << label << "| " << stats.median << "s / " << stats.min << "s / " << stats.p95 << "s / "
+                << stats.p99 << "s | " << (stats.median > 0 ? n / stats.median / 1e6 : 0) << " Melem/s";
 
-        auto *sbh = new SAC::SortingBinHeap<int>(array2, n, true);
-        start_time = std::chrono::high_resolution_clock::now();
-        sbh->Sort();
-        end_time = std::chrono::high_resolution_clock::now();
+        for (size_t j = first; j < results.size() && threads_used > 1; j++) {
+            if (results[j].algorithm == result.algorithm && results[j].threads == 1) {
+                std::cout << " | x" << BM::Summarize(results[j].times).median / stats.median;
+            }
+        }
+        std::cout << std::endl;
+
+        if (!result.metrics.Values().empty()) {
+            std::cout << std::string(LABEL_WIDTH, ' ') << "|";
+            for (const auto &[name, value]: result.metrics.Values()) {
+                std::cout << " " << name << " " << value;
+            }
+            std::cout << std::endl;
+        }
+
+        all_correct = all_correct && result.correct;
+    }
+
+    std::cout << std::string("Arrays equal").append(LABEL_WIDTH - 12, ' ') << "| " << (all_correct ? "yes" : "no")
+            << std::endl;
+    std::cout << "-----------------------------" << std::endl << std::endl;
+}
 
-        std::chrono::duration<double> heap_sort_time = end_time - start_time;
-        std::cout << "Heap " << PrintArray(array2, n, 8) << std::endl;
+void TestForInts(const BM::Options &options, bool print_summary, std::vector<BM::Result> &results) {
+    std::vector<Algorithm<int> > algorithms = IntAlgorithms(options);
 
+    for (const std::string &spec: options.distributions) {
+        GEN::Distribution dist = GEN::Parse(spec);
 
-        start_time = std::chrono::high_resolution_clock::now();
-        SAC::BucketSort(array3, n, m);
-        end_time = std::chrono::high_resolution_clock::now();
+        for (size_t n: options.sizes) {
+            int *input = new int[n];
+            int *reference = new int[n];
+            GEN::Generate(input, n, options.m, dist, options.seed + n);
+            memcpy(reference, input, n * sizeof(int));
+            std::sort(reference, reference + n);
 
-        std::chrono::duration<double> bucket_sort_time = end_time - start_time;
-        std::cout << "Bucket " << PrintArray(array3, n, 8) << std::endl;
+            if (options.preview && print_summary) {
+                std::cout << "Initial " << PrintArray(input, n, options.preview) << std::endl;
+            }
 
+            size_t first = results.size();
+            for (const Algorithm<int> &algorithm: algorithms) {
+                if (BM::Selected(options, algorithm.name)) {
+                    results.push_back(RunAlgorithm(options, "ints", dist.name, algorithm, input, reference, n));
+                }
+            }
 
-        double total_time = counting_sort_time.count() + heap_sort_time.count() + bucket_sort_time.count();
-        std::cout << "-----------SUMMARY-----------" << std::endl;
-        std::cout << "n             | " << n << std::endl;
-        std::cout << "m             | " << m << std::endl;
-        std::cout << "              | " << std::endl;
-        std::cout << "Counting sort | " << counting_sort_time.count() << "s" << std::endl;
-        std::cout << "Heap sort     | " << heap_sort_time.count() << "s" << std::endl;
-        std::cout << "Bucket sort   | " << bucket_sort_time.count() << "s" << std::endl;
-        std::cout << "              | " << std::endl;
-        std::cout << "Total         | " << total_time << "s" << std::endl;
-        std::cout << "Arrays equal  | " << (CompareArrays(array1, array2, array3, n) ? "yes" : "no") << std::endl;
-        std::cout << "-----------------------------" << std::endl << std::endl;
+            if (print_summary) {
+                std::cout << "==========================================================" << std::endl;
+                std::cout << "Ints" << std::endl << std::endl;
+                PrintSummary(results, first, dist.name, n, options.m);
+            }
 
-        delete[] array1;
-        delete[] array2;
-        delete[] array3;
+            delete[] input;
+            delete[] reference;
+        }
     }
 }
 
-void TestForObjects(const int MAX_ORDER, const int m, std::default_random_engine &dre) {
+void TestForObjects(const BM::Options &options, bool print_summary, std::vector<BM::Result> &results) {
     constexpr int LETTERS_SIZE = 36;
     constexpr char LETTERS[LETTERS_SIZE] = {
         'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V',
         'W', 'X', 'Y', 'Z', '1', '2', '3', '4', '5', '6', '7', '8', '9', '0'
     };
 
-    std::uniform_int_distribution<int> rnd_num(0, m);
-    std::uniform_int_distribution<int> rnd_let(0, LETTERS_SIZE - 1);
+    std::vector<Algorithm<some_object *> > algorithms = ObjectAlgorithms(options);
+    GEN::Distribution letters_dist = GEN::Parse("uniform");
+
+    for (const std::string &spec: options.distributions) {
+        GEN::Distribution dist = GEN::Parse(spec);
+
+        for (size_t n: options.sizes) {
+            int *keys = new int[n];
+            int *letters = new int[n];
+            GEN::Generate(keys, n, options.m, dist, options.seed + n);
+            GEN::Generate(letters, n, LETTERS_SIZE - 1, letters_dist, GEN::Hash(options.seed + n));
+
+            some_object *objects = new some_object[n];
+            some_object **input = new some_object *[n];
+            some_object **reference = new some_object *[n];
+            unsigned int threads = static_cast<unsigned int>(std::min<size_t>(TP::Threads(), n ? n : 1));
+            TP::ParallelFor(threads, [&](unsigned int tid) {
+                for (size_t j = TP::ChunkBegin(n, threads, tid); j < TP::ChunkBegin(n, threads, tid + 1); j++) {
+                    objects[j].field_1 = options.m ? static_cast<double>(keys[j]) / options.m : 0;
+                    objects[j].field_2 = LETTERS[letters[j]];
+                    input[j] = objects + j;
+                }
+            });
+            delete[] keys;
+            delete[] letters;
+
+            memcpy(reference, input, n * sizeof(some_object *));
+            std::sort(reference, reference + n, [](some_object *so1, some_object *so2) {
+                return so_cmp_lgreater(so2, so1);
+            });
+
+            if (options.preview && print_summary) {
+                std::cout << "Initial " << PrintArray(input, n, options.preview, so_fun_str) << std::endl;
+            }
+
+            size_t first = results.size();
+            for (const Algorithm<some_object *> &algorithm: algorithms) {
+                if (BM::Selected(options, algorithm.name)) {
+                    results.push_back(RunAlgorithm(options, "objects", dist.name, algorithm, input, reference, n,
+                                                   so_cmp_equal, so_fun_str));
+                }
+            }
 
-    for (int i = 1; i <= MAX_ORDER; i++) {
-        std::cout << "==========================================================" << std::endl;
-        std::cout << "Test: " << i << std::endl << std::endl;
+            if (print_summary) {
+                std::cout << "==========================================================" << std::endl;
+                std::cout << "Objects" << std::endl << std::endl;
+                PrintSummary(results, first, dist.name, n, options.m);
+            }
 
-        int n = static_cast<int>(pow(10, i));
+            delete[] objects;
+            delete[] input;
+            delete[] reference;
+        }
+    }
+}
 
-        some_object **array1 = new some_object *[n];
-        some_object **array2 = new some_object *[n];
+void TestForMerge(const BM::Options &options, bool print_summary, std::vector<BM::Result> &results) {
+    constexpr size_t MAX_WAYS = 1024;
+
+    for (const std::string &spec: options.distributions) {
+        GEN::Distribution dist = GEN::Parse(spec);
+
+        for (size_t n: options.sizes) {
+            int *input = new int[n];
+            int *reference = new int[n];
+            GEN::Generate(input, n, options.m, dist, options.seed + n);
+            memcpy(reference, input, n * sizeof(int));
+            std::sort(reference, reference + n);
+
+            for (size_t k = 2; k <= MAX_WAYS && k <= n; k *= 2) {
+                for (size_t i = 0; i < k; i++) {
+                    std::sort(input + TP::ChunkBegin(n, k, i), input + TP::ChunkBegin(n, k, i + 1));
+                }
+
+                size_t first = results.size();
+                for (const Algorithm<int> &algorithm: MergeAlgorithms(k)) {
+                    if (BM::Selected(options, algorithm.name)) {
+                        results.push_back(RunAlgorithm(options, "merge", dist.name, algorithm, input, reference, n));
+                    }
+                }
+
+                if (print_summary) {
+                    std::cout << "==========================================================" << std::endl;
+                    std::cout << "Merge (k = " << k << ")" << std::endl << std::endl;
+                    PrintSummary(results, first, dist.name, n, options.m);
+                }
+            }
 
-        for (int j = 0; j < n; j++) {
-            some_object *so = new some_object();
-            so->field_1 = static_cast<double>(rnd_num(dre)) / m;
-            so->field_2 = LETTERS[rnd_let(dre)];
-            array1[j] = so;
+            delete[] input;
+            delete[] reference;
         }
-        memcpy(array2, array1, n * sizeof(some_object *));
+    }
+}
 
-        std::cout << "Initial " << PrintArray(array1, n, 8, so_fun_str) << std::endl;
+bool CheckExternalOutput(const std::string &path, size_t n, uint64_t checksum) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<int> buffer(ES::MIN_BUFFER_INTS);
+    uint64_t sum = 0;
+    size_t count = 0;
+    bool sorted = true;
+    int last = 0;
+
+    while (file) {
+        file.read(reinterpret_cast<char *>(buffer.data()), buffer.size() * sizeof(int));
+        size_t length = static_cast<size_t>(file.gcount()) / sizeof(int);
+        for (size_t i = 0; i < length; i++) {
+            sorted = sorted && (count + i == 0 || last <= buffer[i]);
+            last = buffer[i];
+            sum += GEN::Hash(static_cast<uint64_t>(buffer[i]));
+        }
+        count += length;
+    }
 
+    return sorted && count == n && sum == checksum;
+}
 
-        auto *sbh = new SAC::SortingBinHeap<some_object *>(array1, n, true, so_cmp_lgreater);
-        std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
-        sbh->Sort(so_cmp_lgreater);
-        std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+void TestForExternal(const BM::Options &options, bool print_summary, std::vector<BM::Result> &results) {
+    const std::vector<std::pair<std::string, ES::RunSort> > algorithms = {
+        {"external-counting", ES::RunSort::COUNTING}, {"external-heap", ES::RunSort::HEAP}
+    };
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string input_path = (directory / ("sac_external_" + std::to_string(getpid()) + ".in")).string();
+    std::string output_path = (directory / ("sac_external_" + std::to_string(getpid()) + ".out")).string();
+
+    for (const std::string &spec: options.distributions) {
+        GEN::Distribution dist = GEN::Parse(spec);
+
+        for (size_t n: options.sizes) {
+            size_t memory = options.memory ? options.memory
+                                           : std::max<size_t>(ES::MIN_MEMORY_BYTES, n * sizeof(int) / 8);
+            size_t chunk = std::min(n, memory / sizeof(int)) / GEN::BLOCK_SIZE * GEN::BLOCK_SIZE;
+            chunk = std::max(GEN::BLOCK_SIZE, chunk);
+            uint64_t checksum = 0;
+
+            std::ofstream input_file(input_path, std::ios::binary | std::ios::trunc);
+            int *buffer = new int[chunk];
+            for (size_t begin = 0; begin < n; begin += chunk) {
+                size_t length = std::min(chunk, n - begin);
+                GEN::GenerateRange(buffer, n, begin, length, options.m, dist, options.seed + n);
+                for (size_t i = 0; i < length; i++) {
+                    checksum += GEN::Hash(static_cast<uint64_t>(buffer[i]));
+                }
+                input_file.write(reinterpret_cast<const char *>(buffer), length * sizeof(int));
+            }
+            delete[] buffer;
+            input_file.close();
+            if (!input_file) {
+                throw std::runtime_error("TestForExternal(): could not write " + input_path);
+            }
 
-        std::chrono::duration<double> heap_sort_time = end_time - start_time;
-        std::cout << "Heap " << PrintArray(array1, n, 8, so_fun_str) << std::endl;
+            size_t first = results.size();
+            for (const auto &[name, run_sort]: algorithms) {
+                if (!BM::Selected(options, name)) {
+                    continue;
+                }
+
+                BM::Result result;
+                result.suite = "external";
+                result.distribution = dist.name;
+                result.algorithm = name;
+                result.n = n;
+                result.m = options.m;
+                result.seed = options.seed;
+
+                ES::Stats stats;
+                for (size_t trial = 0; trial < options.warmup + options.trials; trial++) {
+                    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+                    stats = ES::ExternalSort(input_path, output_path, memory, run_sort);
+                    std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+                    if (trial >= options.warmup) {
+                        result.times.push_back(std::chrono::duration<double>(end_time - start_time).count());
+                    }
+                }
+
+                result.metrics.Set("memory-bytes", static_cast<double>(memory));
+                result.metrics.Set("runs", static_cast<double>(stats.runs));
+                result.metrics.Set("merge-passes", static_cast<double>(stats.merge_passes));
+                result.metrics.Set("bytes-read", static_cast<double>(stats.bytes_read));
+                result.metrics.Set("bytes-written", static_cast<double>(stats.bytes_written));
+                result.metrics.Set("run-s", stats.run_seconds);
+                result.metrics.Set("merge-s", stats.merge_seconds);
+                result.correct = CheckExternalOutput(output_path, n, checksum);
+                results.push_back(result);
+            }
 
+            if (print_summary) {
+                std::cout << "==========================================================" << std::endl;
+                std::cout << "External" << std::endl << std::endl;
+                PrintSummary(results, first, dist.name, n, options.m);
+            }
+        }
+    }
 
-        start_time = std::chrono::high_resolution_clock::now();
-        SAC::BucketSort(array2, n, m, so_cmp_lgreater, so_fun_key);
-        end_time = std::chrono::high_resolution_clock::now();
+    std::filesystem::remove(input_path);
+    std::filesystem::remove(output_path);
+}
 
-        std::chrono::duration<double> bucket_sort_time = end_time - start_time;
-        std::cout << "Bucket " << PrintArray(array2, n, 8, so_fun_str) << std::endl;
+int main(int argc, char **argv) {
+    DA::on_allocate = MEM::OnAllocate;
+    DA::on_deallocate = MEM::OnDeallocate;
 
+    BM::Options options;
+    try {
+        options = BM::ParseOptions(argc, argv);
+        for (const std::string &spec: options.distributions) {
+            GEN::Parse(spec);
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl << BM::Usage();
+        return 1;
+    }
 
-        double total_time = heap_sort_time.count() + bucket_sort_time.count();
-        std::cout << "-----------SUMMARY-----------" << std::endl;
-        std::cout << "n             | " << n << std::endl;
-        std::cout << "m             | " << m << std::endl;
-        std::cout << "              | " << std::endl;
-        std::cout << "Heap sort     | " << heap_sort_time.count() << "s" << std::endl;
-        std::cout << "Bucket sort   | " << bucket_sort_time.count() << "s" << std::endl;
-        std::cout << "              | " << std::endl;
-        std::cout << "Total         | " << total_time << "s" << std::endl;
-        std::cout << "Arrays equal  | " << (CompareArrays(array1, array2, array2, n, so_cmp_equal) ? "yes" : "no") <<
-                std::endl;
-        std::cout << "-----------------------------" << std::endl << std::endl;
+    if (options.help) {
+        std::cout << BM::Usage();
+        return 0;
+    }
 
-        for (size_t j = 0; j < n; j++) {
-            delete array1[j];
+    bool print_summary = options.format == "text" || !options.output.empty();
+    PC::Counters probe;
+    if (!probe.Missing().empty()) {
+        std::cerr << "main(): performance counters unavailable:";
+        for (const std::string &name: probe.Missing()) {
+            std::cerr << " " << name;
         }
-        delete[] array1;
-        delete[] array2;
+        std::cerr << std::endl;
     }
-}
+    std::vector<BM::Result> results;
 
-int main() {
-    constexpr int MAX_ORDER = 6;
-    const int m = static_cast<int>(pow(10, 7));
+    if (options.suite == "ints" || options.suite == "all") {
+        TestForInts(options, print_summary, results);
+    }
+    if (options.suite == "objects" || options.suite == "all") {
+        TestForObjects(options, print_summary, results);
+    }
+    if (options.suite == "merge") {
+        TestForMerge(options, print_summary, results);
+    }
+    if (options.suite == "external") {
+        try {
+            TestForExternal(options, print_summary, results);
+        } catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            return 1;
+        }
+    }
 
-    static std::random_device rd;
-    static std::default_random_engine dre(rd());
+    if (options.format != "text") {
+        std::string report = options.format == "csv" ? BM::ToCsv(results) : BM::ToJson(results);
+        if (options.output.empty()) {
+            std::cout << report;
+        } else {
+            std::ofstream file(options.output);
+            file << report;
+            if (!file) {
+                std::cerr << "main(): could not write " << options.output << std::endl;
+                return 1;
+            }
+        }
+    }
 
-    TestForInts(MAX_ORDER, m, dre);
-    //TestForObjects(MAX_ORDER, m, dre);
+    for (const BM::Result &result: results) {
+        if (!result.correct) {
+            return 2;
+        }
+    }
 
     return 0;
 }